@@ -1,51 +1,51 @@
-#version 330 core
-out vec4 FragColor;
-
-in vec2 TexCoord;
-in vec3 SurfColor;
-in vec3 Normal;
-in vec3 FragPos;
-
-// texture samplers
-uniform sampler2D texture1;
-uniform bool TEX_ENABLE;
-
-uniform vec3 lightPos; 
-uniform vec3 viewPos; 
-uniform vec3 lightColor;
-//uniform vec3 objectColor;
-
-void main()
-{
-	// ambient
-    float ambientStrength = 0.1;
-    vec3 ambient = ambientStrength * lightColor;
-  	
-    // diffuse 
-    vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
-    
-    // specular
-    float specularStrength = 0.5;
-    vec3 viewDir = normalize(viewPos - FragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);  
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = specularStrength * spec * lightColor;  
-        
-    vec3 result = (ambient + diffuse + specular) * SurfColor;
-    //FragColor = vec4(result, 1.0);
-
-	if (!TEX_ENABLE)
-	{
-		FragColor = vec4(result, 1.f);
-		//FragColor = vec4(0.2f, 0.2f, 0.7f, 1.f);
-	}
-	else
-	{
-		FragColor = texture(texture1, TexCoord) * vec4(result, 1.f);
-	}
-
-
+#version 330 core
+out vec4 FragColor;
+
+in vec3 TexCoord;
+in vec3 SurfColor;
+in vec3 Normal;
+in vec3 FragPos;
+
+// texture samplers
+uniform sampler2DArray texture1;
+uniform bool TEX_ENABLE;
+
+uniform vec3 lightPos; 
+uniform vec3 viewPos; 
+uniform vec3 lightColor;
+//uniform vec3 objectColor;
+
+void main()
+{
+	// ambient
+    float ambientStrength = 0.1;
+    vec3 ambient = ambientStrength * lightColor;
+  	
+    // diffuse 
+    vec3 norm = normalize(Normal);
+    vec3 lightDir = normalize(lightPos - FragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor;
+    
+    // specular
+    float specularStrength = 0.5;
+    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);  
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+    vec3 specular = specularStrength * spec * lightColor;  
+        
+    vec3 result = (ambient + diffuse + specular) * SurfColor;
+    //FragColor = vec4(result, 1.0);
+
+	if (!TEX_ENABLE)
+	{
+		FragColor = vec4(result, 1.f);
+		//FragColor = vec4(0.2f, 0.2f, 0.7f, 1.f);
+	}
+	else
+	{
+		FragColor = texture(texture1, TexCoord) * vec4(result, 1.f);
+	}
+
+
 }
\ No newline at end of file
@@ -1,24 +1,27 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-layout (location = 2) in vec3 aColor;
-layout (location = 3) in vec3 aNormal;
-
-out vec2 TexCoord;
-out vec3 SurfColor;
-out vec3 Normal;
-out vec3 FragPos;
-
-uniform mat4 model;
-//uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-	FragPos = vec3(model * vec4(aPos, 1.0));
-	Normal = mat3(transpose(inverse(model))) * aNormal;
-
-	gl_Position = projection  * vec4(FragPos, 1.0f);
-	TexCoord = vec2(aTexCoord.x, aTexCoord.y);
-	SurfColor = aColor;
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec3 aColor;
+layout (location = 3) in vec3 aNormal;
+layout (location = 4) in vec4 aOffsetLayer; // per instance: xyz offset, w atlas layer
+layout (location = 5) in vec4 aUVRect;      // per instance: atlas rectangle, xy offset, zw size
+layout (location = 6) in mat3 aRotation;    // per instance: spin around the cube's center
+
+out vec3 TexCoord;
+out vec3 SurfColor;
+out vec3 Normal;
+out vec3 FragPos;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+	FragPos = vec3(model * vec4(aRotation * aPos + aOffsetLayer.xyz, 1.0));
+	Normal = mat3(transpose(inverse(model))) * (aRotation * aNormal);
+
+	gl_Position = projection * view * vec4(FragPos, 1.0f);
+	TexCoord = vec3(aUVRect.xy + aTexCoord * aUVRect.zw, aOffsetLayer.w);
+	SurfColor = aColor;
 }
\ No newline at end of file
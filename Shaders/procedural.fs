@@ -0,0 +1,71 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 UV;
+
+uniform int PATTERN;	// 0 noise, 1 checker, 2 matrix rain
+uniform float SCALE;	// cells across the texture
+uniform float TIME;
+
+float hash(vec2 p)
+{
+	return fract(sin(dot(p, vec2(127.1, 311.7))) * 43758.5453);
+}
+
+// value noise with smooth interpolation between the lattice points
+float noise(vec2 p)
+{
+	vec2 i = floor(p);
+	vec2 f = fract(p);
+	vec2 u = f * f * (3.0 - 2.0 * f);
+	return mix(mix(hash(i), hash(i + vec2(1.0, 0.0)), u.x),
+	           mix(hash(i + vec2(0.0, 1.0)), hash(i + vec2(1.0, 1.0)), u.x), u.y);
+}
+
+float fbm(vec2 p)
+{
+	float value = 0.0;
+	float amplitude = 0.5;
+	for (int i = 0; i < 5; i++)
+	{
+		value += amplitude * noise(p);
+		p *= 2.0;
+		amplitude *= 0.5;
+	}
+	return value;
+}
+
+void main()
+{
+	vec2 p = UV * SCALE;
+
+	if (PATTERN == 0)
+	{
+		float n = fbm(p + vec2(TIME * 0.5, TIME * 0.2));
+		FragColor = vec4(vec3(n), 1.0);
+	}
+	else if (PATTERN == 1)
+	{
+		vec2 cell = floor(p);
+		float k = mod(cell.x + cell.y, 2.0);
+		FragColor = vec4(vec3(0.15 + 0.7 * k), 1.0);
+	}
+	else
+	{
+		// every column has its own falling head with a fading trail above it
+		vec2 cell = floor(p);
+		vec2 f = fract(p);
+		float speed = 0.05 + 0.2 * hash(vec2(cell.x, 0.0));
+		float head = fract(hash(vec2(cell.x, 1.0)) - TIME * speed);
+		float trail = fract((cell.y + 0.5) / SCALE - head);
+		float brightness = pow(1.0 - trail, 6.0);
+
+		// a random 3x5 glyph per cell that changes a few times per second
+		vec2 bit = floor(f * vec2(3.0, 5.0));
+		float glyph = step(0.45, hash(cell * 13.0 + bit + floor(TIME * 4.0 + hash(cell) * 8.0)));
+		float inside = step(0.1, f.x) * step(f.x, 0.9) * step(0.05, f.y) * step(f.y, 0.95);
+
+		vec3 color = mix(vec3(0.1, 1.0, 0.35), vec3(0.85, 1.0, 0.9), step(0.985, 1.0 - trail));
+		FragColor = vec4(color * brightness * glyph * inside, 1.0);
+	}
+}
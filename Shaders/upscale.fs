@@ -0,0 +1,29 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 UV;
+
+uniform sampler2D SCENE;
+uniform vec2 SCENE_SIZE;	// pixels of the texture the scene was rendered into
+uniform vec2 TEXTURE_SIZE;	// pixels of the whole texture, the scene only fills its lower left part
+uniform float SHARPNESS;	// 0 plain bilinear, up to 1 for a strong unsharp mask
+
+// stay half a texel inside the rendered part, bilinear filtering would blend in what lies beyond it
+vec3 scene(vec2 pixel)
+{
+	return texture(SCENE, clamp(pixel, vec2(0.5), SCENE_SIZE - 0.5) / TEXTURE_SIZE).rgb;
+}
+
+void main()
+{
+	vec2 pixel = UV * SCENE_SIZE;
+	vec3 color = scene(pixel);
+	if (SHARPNESS > 0.0)
+	{
+		// unsharp mask: push the pixel away from the average of its neighbours in the low resolution image
+		vec3 neighbours = scene(pixel + vec2(1.0, 0.0)) + scene(pixel - vec2(1.0, 0.0))
+		                + scene(pixel + vec2(0.0, 1.0)) + scene(pixel - vec2(0.0, 1.0));
+		color = clamp(color + SHARPNESS * (color - neighbours * 0.25), 0.0, 1.0);
+	}
+	FragColor = vec4(color, 1.0);
+}
@@ -1,805 +1,1749 @@
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-#include <stb_image/stb_image.h>
-
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include <shader/shader_m.h>
-
-#include "imgui/imgui.h"
-#include "imgui/imgui_impl_glfw.h"
-#include "imgui/imgui_impl_opengl3.h"
-
-#include <iostream>
-#include <shader/camera.h>
-
-void framebuffer_size_callback(GLFWwindow* window, int width, int height);
-void processInput(GLFWwindow* window);
-glm::mat4 ShearTransform(glm::mat4 model, float SaX, float SaY, float SaZ);
-glm::mat4 Mirror(glm::mat4 model, float aXY, float aXZ, float aYZ);
-
-// settings
-const unsigned int SCR_WIDTH = 1920;
-const unsigned int SCR_HEIGHT = 1080;
-
-// camera
-Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
-float lastX = SCR_WIDTH / 2.0f;
-float lastY = SCR_HEIGHT / 2.0f;
-bool firstMouse = true;
-
-// timing
-float deltaTime = 0.0f;
-float lastFrame = 0.0f;
-
-// lighting
-glm::vec3 lightPos(1.f, 1.f, -5.f);
-
-int main()
-{
-    // glfw: initialize and configure
-    // ------------------------------
-    glfwInit();
-    const char* glsl_version = "#version 130";
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-
-    // glfw window creation
-    // --------------------
-    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "CG Cube", NULL, NULL);
-    if (window == NULL)
-    {
-        std::cout << "Failed to create GLFW window" << std::endl;
-        glfwTerminate();
-        return -1;
-    }
-    glfwMakeContextCurrent(window);
-    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-
-    // glad: load all OpenGL function pointers
-    // ---------------------------------------
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-    {
-        std::cout << "Failed to initialize GLAD" << std::endl;
-        return -1;
-    }
-
-    // configure global opengl state
-    // -----------------------------
-    glEnable(GL_DEPTH_TEST);
-
-    // build and compile our shader zprogram
-    // ------------------------------------
-    Shader ourShader("Shaders/cube3d.vs", "Shaders/cube3d.fs");
-    Shader lightCubeShader("Shaders/2.2.light_cube.vs", "Shaders/2.2.light_cube.fs");
-
-    // set up vertex data (and buffer(s)) and configure vertex attributes
-    // ------------------------------------------------------------------
-    float vertices[] = {
-        //positions         //texture coords // color surfaces //normals
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
-         0.5f, -0.5f, -0.5f,  1.0f, 0.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
-
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
-
-        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
-        -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
-        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
-
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
-         0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
-
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
-         0.5f, -0.5f, -0.5f,  1.0f, 1.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
-
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f
-    };
-    //first configure the cube's VAO and VBO
-    unsigned int VBO, VAO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    // position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // texture coord attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    // color surface attribute
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(5 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    // normal attribute
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(8 * sizeof(float)));
-    glEnableVertexAttribArray(3);
-
-    // second, configure the light's VAO (VBO stays the same; the vertices are the same for the light object which is also a 3D cube)
-    unsigned int lightCubeVAO;
-    glGenVertexArrays(1, &lightCubeVAO);
-    glBindVertexArray(lightCubeVAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    // note that we update the lamp's position attribute's stride to reflect the updated buffer data
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // load and create a texture 
-    // -------------------------
-    unsigned int texture1;
-    // texture 1
-    // ---------
-    glGenTextures(1, &texture1);
-    glBindTexture(GL_TEXTURE_2D, texture1);
-    // set the texture wrapping parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    // set texture filtering parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    // load image, create texture and generate mipmaps
-    int width, height, nrChannels;
-    stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
-    unsigned char* data = stbi_load("textures/matrix.jpg", &width, &height, &nrChannels, 0);
-    if (data)
-    {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    }
-    else
-    {
-        std::cout << "Failed to load texture" << std::endl;
-    }
-   
-
-    // tell opengl for each sampler to which texture unit it belongs to (only has to be done once)
-    // -------------------------------------------------------------------------------------------
-    ourShader.use();
-    ourShader.setInt("texture1", 0);
-    
-    // Setup Dear ImGui context
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGuiIO& io = ImGui::GetIO(); (void)io;
-    //io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
-    //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
-
-    // Setup Dear ImGui style
-    //ImGui::StyleColorsDark();
-    ImGui::StyleColorsClassic();
-    //ImGui::StyleColorsLight();
-    // Setup Platform/Renderer backends
-    ImGui_ImplGlfw_InitForOpenGL(window, true);
-    ImGui_ImplOpenGL3_Init(glsl_version);
-
-    
-    ImVec4 clear_color = ImVec4(1.f, 0.1f, 0.2f, 1.00f);
-
-
-    // render loop
-    // -----------
-    while (!glfwWindowShouldClose(window))
-    {
-        // per-frame time logic
-        // --------------------
-        float currentFrame = glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
-
-        // input
-        // -----
-        processInput(window);
-        // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-        
-        
-        // 2. Show a simple window that we create ourselves. We use a Begin/End pair to created a named window
-        
-        //current value holders
-        static float TRANSLATE_X = 0.0f;
-        static float TRANSLATE_Y = 0.0f;
-        static float TRANSLATE_Z = 0.0f;
-
-        static float ROTATE_X = 0.0f;
-        static float ROTATE_Y = 0.0f;
-        static float ROTATE_Z = 0.0f;
-        static float RP_X = 0.0f;
-        static float RP_Y = 0.0f;
-        static float RP_Z = 0.0f;
-
-        static float SCALE_X = 1.0f;
-        static float SCALE_Y = 1.0f;
-        static float SCALE_Z = 1.0f;
-        static float Sk = 1.0f;
-
-        static bool  ASPECT_RATIO = true;
-        static bool ROTATE_ENABLE = false;
-        static bool TRANSLATE_ENABLE = false;
-        static bool SCALE_ENABLE = false;
-        static bool PERSPECTIVE_ENABLE = true;
-        static bool WIREFRAME = false;
-        static bool TEX_ENABLE = true;
-        static bool SHEAR_ENABLE = false;
-        static bool MIRROR_ENABLE = false;
-
-        static bool SaX_ENABLE = false;
-        static bool SaY_ENABLE = false;
-        static bool SaZ_ENABLE = false;
-
-        static bool mXY_ENABLE = false;
-        static bool mXZ_ENABLE = false;
-        static bool mYZ_ENABLE = false;
-
-        //past value holders
-        static float tra_x = 0.f;
-        static float tra_y = 0.f;
-        static float tra_z = 0.f;
-
-        static float rot_x = 0.f;
-        static float rot_y = 0.f;
-        static float rot_z = 0.f;
-
-        static float rp_x = 0.0f;
-        static float rp_y = 0.0f;
-        static float rp_z = 0.0f;
-
-        static float sca_x = 1.f;
-        static float sca_y = 1.f;
-        static float sca_z = 1.f;
-
-        static float past_sax = 0.f;
-        static float past_say = 0.f;
-        static float past_saz = 0.f;
-
-        static float past_mxy = 0.f;
-        static float past_mxz = 0.f;
-        static float past_myz = 0.f;
-        
-        static float Lx = 0.0f;
-        static float Ly = 0.0f;
-        static float Lz = -5.f;
-
-        if (WIREFRAME) {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        }
-        else
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-        ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
-        ImGui::Begin("Options");                          // Create a window called "Hello, world!" and append into it.
-        
-
-        // TRANSLATE
-        ImGui::Text("Translation");
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Tx", &TRANSLATE_X, .1f, 1.0f, "%.3f");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Ty", &TRANSLATE_Y, .1f, 1.0f, "%.3f");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Tz", &TRANSLATE_Z, .1f, 1.0f, "%.3f");
-        ImGui::SameLine();
-
-        if (ImGui::Button("Translate"))
-            TRANSLATE_ENABLE = true;
-        
-        // ROTATE by Angle
-        ImGui::Text("Rotation");
-        ImGui::Text("Angle"); ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Rx", &ROTATE_X, 1.f, 1.0f, "%.3f");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Ry", &ROTATE_Y, 1.f, 1.0f, "%.3f");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Rz", &ROTATE_Z, 1.f, 1.0f, "%.3f");
-
-        //ROTATE by point
-        ImGui::Text("Point"); ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("PRx", &RP_X, 1.f, 1.0f, "%.3f");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("PRy", &RP_Y, 1.f, 1.0f, "%.3f");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("PRz", &RP_Z, 1.f, 1.0f, "%.3f");
-        ImGui::SameLine();
-
-        if (ImGui::Button("Rotate"))
-            ROTATE_ENABLE = true;
-
-        // SCALE
-        if (ASPECT_RATIO) {
-            ImGui::Text("Scaling");
-            ImGui::SetNextItemWidth(100);
-            ImGui::InputFloat("Sx", &Sk, 0.1f, 1.0f, "%.3f");
-            ImGui::SameLine();
-            ImGui::SetNextItemWidth(100);
-            ImGui::InputFloat("Sy", &Sk, 0.1f, 1.0f, "%.3f");
-            ImGui::SameLine();
-            ImGui::SetNextItemWidth(100);
-            ImGui::InputFloat("Sz", &Sk, .1f, 1.0f, "%.3f");
-            ImGui::SameLine();
-        }
-
-        else {
-            ImGui::Text("Scaling");
-            ImGui::SetNextItemWidth(100);
-            ImGui::InputFloat("Sx", &SCALE_X, .1f, 1.0f, "%.3f");
-            ImGui::SameLine();
-            ImGui::SetNextItemWidth(100);
-            ImGui::InputFloat("Sy", &SCALE_Y, .1f, 1.0f, "%.3f");
-            ImGui::SameLine();
-            ImGui::SetNextItemWidth(100);
-            ImGui::InputFloat("Sz", &SCALE_Z, .1f, 1.0f, "%.3f");
-            ImGui::SameLine();
-        }
-
-        if (ImGui::Button("Scale"))
-            SCALE_ENABLE = true;
-
-        if (ImGui::Button("Reset"))
-        {
-             TRANSLATE_X = 0.0f;
-             TRANSLATE_Y = 0.0f;
-             TRANSLATE_Z = 0.0f;
-
-             ROTATE_X = 0.0f;
-             ROTATE_Y = 0.0f;
-             ROTATE_Z = 0.0f;
-             RP_X = 0.0f;
-             RP_Y = 0.0f;
-             RP_Z = 0.0f;
-
-             SCALE_X = 1.0f;
-             SCALE_Y = 1.0f;
-             SCALE_Z = 1.0f;
-             Sk = 1.0f;
-
-             ASPECT_RATIO = true;
-             ROTATE_ENABLE = false;
-             TRANSLATE_ENABLE = false;
-             SCALE_ENABLE = false;
-             PERSPECTIVE_ENABLE = true;
-             WIREFRAME = false;
-             TEX_ENABLE = true;
-             SHEAR_ENABLE = false;
-             MIRROR_ENABLE = false;
-             
-             SaX_ENABLE = false;
-             SaY_ENABLE = false;
-             SaZ_ENABLE = false;
-
-             mXY_ENABLE = false;
-             mXZ_ENABLE = false;
-             mYZ_ENABLE = false;
-            //past value holders
-             tra_x = 0.f;
-             tra_y = 0.f;
-             tra_z = 0.f;
-
-             rot_x = 0.f;
-             rot_y = 0.f;
-             rot_z = 0.f;
-
-             rp_x = 0.f;
-             rp_y = 0.f;
-             rp_z = 0.f;
-
-             sca_x = 1.f;
-             sca_y = 1.f;
-             sca_z = 1.f;
-
-             past_sax = 0.f;
-             past_say = 0.f;
-             past_saz = 0.f;
-
-             past_mxy = 0.f;
-             past_mxz = 0.f;
-             past_myz = 0.f;
-        }
-
-        ImGui::Checkbox("Keep Aspect Ratio", &ASPECT_RATIO);
-        ImGui::Checkbox("Perspective/Ortho", &PERSPECTIVE_ENABLE);
-        ImGui::Checkbox("Fill/Wireframe", &WIREFRAME);
-        ImGui::Checkbox("Texture ON/OFF", &TEX_ENABLE);
-
-        if (ImGui::Button("Shear")) {
-            SHEAR_ENABLE = true;
-        }
-        ImGui::SameLine();
-        ImGui::Checkbox("X", &SaX_ENABLE); ImGui::SameLine();
-        ImGui::Checkbox("Y", &SaY_ENABLE); ImGui::SameLine();
-        ImGui::Checkbox("Z", &SaZ_ENABLE); 
-
-        if (ImGui::Button("Mirror")) {
-            MIRROR_ENABLE = true;
-        }
-        ImGui::SameLine();
-        ImGui::Checkbox("XY", &mXY_ENABLE); ImGui::SameLine();
-        ImGui::Checkbox("XZ", &mXZ_ENABLE); ImGui::SameLine();
-        ImGui::Checkbox("YZ", &mYZ_ENABLE);
-
-        //Light bulb position
-        ImGui::Text("Bulb"); ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Lx", &Lx, 1.f, 1.0f, "%.3f");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Ly", &Ly, 1.f, 1.0f, "%.3f");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth(100);
-        ImGui::InputFloat("Lz", &Lz, 1.f, 1.0f, "%.3f");
-        ImGui::SameLine();
-
-        ImGui::End();
-
-        // render
-        // ------
-        
-        glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // also clear the depth buffer now!
-        
-
-        // bind textures on corresponding texture units
-        if (TEX_ENABLE) {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, texture1);
-        }
-        else {
-            glActiveTexture(NULL);
-            glBindTexture(GL_TEXTURE_2D, NULL);
-        }
-
-        // activate shader
-        ourShader.use();
-
-        // create transformations
-        glm::mat4 model = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-        glm::mat4 view = glm::mat4(1.0f);
-        glm::mat4 projection = glm::mat4(1.0f);
-        
-
-        
-        //Translate
-        if (TRANSLATE_ENABLE) {
-            model = glm::translate(model, glm::vec3(TRANSLATE_X, TRANSLATE_Y, TRANSLATE_Z-3.f));
-
-            tra_x = TRANSLATE_X;
-            tra_y = TRANSLATE_Y;
-            tra_z = TRANSLATE_Z;
-
-            TRANSLATE_ENABLE = false;
-        }
-
-        else 
-        {
-            model = glm::translate(model, glm::vec3(tra_x, tra_y, tra_z-3.f));
-        }
-        
-        // Rotate by angle
-        if (ROTATE_ENABLE) {
-            model = glm::translate(model, glm::vec3(RP_X, RP_Y, RP_Z));
-            model = glm::rotate(model, glm::radians(ROTATE_X), glm::vec3(1.f, 0.0f, 0.0f));
-            model = glm::rotate(model, glm::radians(ROTATE_Y), glm::vec3(0.f, 1.f, 0.0f));
-            model = glm::rotate(model, glm::radians(ROTATE_Z), glm::vec3(0.f, 0.0f, 1.f));
-            model = glm::translate(model, glm::vec3(-RP_X, -RP_Y, -RP_Z));
-            
-            rot_x = ROTATE_X;
-            rot_y = ROTATE_Y;
-            rot_z = ROTATE_Z;
-
-            rp_x = RP_X;
-            rp_y = RP_Y;
-            rp_z = RP_Z;
-
-            ROTATE_ENABLE = false;
-        }
-
-        else
-        {
-            model = glm::translate(model, glm::vec3(rp_x, rp_y, rp_z));
-            model = glm::rotate(model, glm::radians(rot_x), glm::vec3(1.f, 0.0f, 0.0f));
-            model = glm::rotate(model, glm::radians(rot_y), glm::vec3(0.f, 1.f, 0.0f));
-            model = glm::rotate(model, glm::radians(rot_z), glm::vec3(0.f, 0.0f, 1.f));
-            model = glm::translate(model, glm::vec3(-rp_x, -rp_y, -rp_z));
-
-        }
-        
-        
-        //SCALE
-        if (SCALE_ENABLE && SCALE_X >= 0 && SCALE_Y >= 0 && SCALE_Z >= 0 && Sk >= 0) {
-            model = glm::scale(model, glm::vec3(SCALE_X, SCALE_Y, SCALE_Z));
-
-            sca_x = SCALE_X;
-            sca_y = SCALE_Y;
-            sca_z = SCALE_Z;
-
-            if (ASPECT_RATIO) {
-                model = glm::scale(model, glm::vec3(Sk*1.f, Sk*1.f, Sk*1.f));
-                sca_x = Sk;
-                sca_y = Sk;
-                sca_z = Sk;
-            }
-
-            if (!PERSPECTIVE_ENABLE) {
-                sca_x = sca_x * 500.f;
-                sca_y = sca_y * 500.f;
-                sca_z = sca_z * 500.f;
-            }
-            
-            SCALE_ENABLE = false;
-        }
-
-        else
-        {
-            model = glm::scale(model, glm::vec3(sca_x, sca_y, sca_z));
-        }
-
-        if (SHEAR_ENABLE) {
-
-            if (SaX_ENABLE) {
-                model = ShearTransform(model, 1.f, 0.f, 0.f);
-                past_sax = 1.f;
-                past_say = 0.f;
-                past_saz = 0.f;
-                SaY_ENABLE = false;
-                SaZ_ENABLE = false;
-            }
-            else if (SaY_ENABLE) {
-                model = ShearTransform(model, 0.f, 1.f, 0.f);
-                past_sax = 0.f;
-                past_say = 1.f;
-                past_saz = 0.f;
-                SaX_ENABLE = false;
-                SaZ_ENABLE = false;
-            }
-            else if (SaZ_ENABLE) {
-                model = ShearTransform(model, 0.f, 0.f, 1.f);
-                past_sax = 0.f;
-                past_say = 0.f;
-                past_saz = 1.f;
-                SaX_ENABLE = false;
-                SaY_ENABLE = false;
-            }
-            else {
-                past_sax = 0.f;
-                past_say = 0.f;
-                past_saz = 0.f;
-            }
-            
-
-            SHEAR_ENABLE = false;
-        }
-
-        else {
-            model = ShearTransform(model, past_sax, past_say, past_saz);
-        }
-
-        if (MIRROR_ENABLE) {
-            if (mXY_ENABLE) {
-                past_mxy = 1.f;
-                past_mxz = 0.f;
-                past_myz = 0.f;
-                model = Mirror(model, past_mxy, 0.f, 0.f);
-
-                mYZ_ENABLE = false;
-                mXZ_ENABLE = false;
-            }
-            else if (mXZ_ENABLE) {
-                past_mxz = 1.f;
-                past_mxy = 0.f;
-                past_myz = 0.f;
-                model = Mirror(model, 0.f, past_mxz, 0.f);
-
-                mXY_ENABLE = false;
-                mYZ_ENABLE = false;
-            }
-            else if (mYZ_ENABLE) {
-                past_myz = 1.f;
-                past_mxy = 0.f;
-                past_mxz = 0.f;
-                model = Mirror(model, 0.f, 0.f, past_myz);
-
-                mXY_ENABLE = false;
-                mXZ_ENABLE = false;
-            }
-            else {
-                past_mxy = 0.f;
-                past_mxz = 0.f;
-                past_myz = 0.f;
-            }
-
-            MIRROR_ENABLE = false;
-        }
-
-        else {
-            model = Mirror(model, past_mxy, past_mxz, past_myz);
-            
-        }
-
-      
-
-        // CHANGE Projection Mode Perspective/Ortho
-        if (PERSPECTIVE_ENABLE) {
-            projection = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, .001f, 100.0f);
-        }
-        else
-        {
-            projection = glm::ortho(
-                -static_cast<float>(SCR_WIDTH / 2.f),
-                static_cast<float>(SCR_WIDTH / 2.f),
-                -static_cast<float>(SCR_HEIGHT /2.f),
-                static_cast<float>(SCR_HEIGHT / 2.f),
-                0.1f,
-                10000.0f
-            );
-            
-        }
-        
-        glm::vec3 lightPos = glm::vec3(Lx, Ly, Lz);
-        // retrieve the matrix uniform locations
-        unsigned int modelLoc = glGetUniformLocation(ourShader.ID, "model");
-        //unsigned int viewLoc = glGetUniformLocation(ourShader.ID, "view");
-        // pass them to the shaders (3 different ways)
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-        //glUniformMatrix4fv(viewLoc, 1, GL_FALSE, &view[0][0]);
-        // note: currently we set the projection matrix each frame, but since the projection matrix rarely changes it's often best practice to set it outside the main loop only once.
-        ourShader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
-        ourShader.setVec3("lightPos", lightPos);
-        ourShader.setVec3("viewPos", camera.Position);
-        ourShader.setMat4("projection", projection);
-        
-        ourShader.setBool("TEX_ENABLE", TEX_ENABLE);
-
-        // render box
-        glBindVertexArray(VAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-
-        // also draw the lamp object
-        lightCubeShader.use();
-        lightCubeShader.setMat4("projection", projection);
-        lightCubeShader.setMat4("view", view);
-        model = glm::mat4(1.0f);
-        model = glm::translate(model, lightPos);
-        if (!PERSPECTIVE_ENABLE) {
-            model = glm::scale(model, glm::vec3(0.1f * 500.f)); // a smaller cube
-        }
-        else {
-            model = glm::scale(model, glm::vec3(0.1f)); // a smaller cube
-        }
-        lightCubeShader.setMat4("model", model);
-
-        glBindVertexArray(lightCubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-        // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-        // -------------------------------------------------------------------------------
-        glfwSwapBuffers(window);
-        glfwPollEvents();
-    }
-
-    // optional: de-allocate all resources once they've outlived their purpose:
-    // ------------------------------------------------------------------------
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteVertexArrays(1, &lightCubeVAO);
-
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
-    ImGui::DestroyContext();
-    // glfw: terminate, clearing all previously allocated GLFW resources.
-    // ------------------------------------------------------------------
-    glfwTerminate();
-    return 0;
-}
-
-// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
-// ---------------------------------------------------------------------------------------------------------
-void processInput(GLFWwindow* window)
-{
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        glfwSetWindowShouldClose(window, true);
-}
-
-// glfw: whenever the window size changed (by OS or user resize) this callback function executes
-// ---------------------------------------------------------------------------------------------
-void framebuffer_size_callback(GLFWwindow* window, int width, int height)
-{
-    // make sure the viewport matches the new window dimensions; note that width and 
-    // height will be significantly larger than specified on retina displays.
-    glViewport(0, 0, width, height);
-}
-glm::mat4 ShearTransform(glm::mat4 model, float SaX, float SaY, float SaZ) {
-    glm::mat4 shear = glm::mat4x4(
-        1.f, 0.f, 0.f, 0.f,
-        0.f, 1.f, 0.f, 0.f,
-        0.f, 0.f, 1.f, 0.f,
-        0.f, 0.f, 0.f, 1.f);
-
-    model = glm::translate(model, glm::vec3(0.f, 0.f, 0.f));
-    // X Shear
-    if (SaX) {
-        shear[0][1] = 1.f;
-        shear[0][2] = 1.f;
-
-    }
-    //Y Shear
-    else if (SaY) {
-        shear[1][0] = 1.f;
-        shear[1][2] = 1.f;
-    }
-    //Z Shear
-    else if (SaZ) {
-        shear[2][0] = 1.f;
-        shear[2][1] = 1.f;
-    }
-    model = shear * model;
-
-    return model;
-}
-
-glm::mat4 Mirror(glm::mat4 model, float aXY, float aXZ, float aYZ) {
-    glm::mat4 reflect = glm::mat4x4(
-        1.f, 0.f, 0.f, 0.f,
-        0.f, 1.f, 0.f, 0.f,
-        0.f, 0.f, 1.f, 0.f,
-        0.f, 0.f, 0.f, 1.f);
-
-    if (aXY) {
-        reflect[2][2] = -1.f;
-    }
-    else if (aXZ) {
-        reflect[1][1] = -1.f;
-    }
-    else if (aYZ) {
-        reflect[0][0] = -1.f;
-    }
-
-    model = reflect * model;
-
-    return model;
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <stb_image/stb_image.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <shader/shader_m.h>
+#include <shader/texture_manager.h>
+#include <shader/texture_atlas.h>
+#include <shader/hot_reload.h>
+#include <shader/procedural_texture.h>
+#include <shader/font_cache.h>
+#include <shader/profiler.h>
+#include <shader/gpu_profiler.h>
+#include <shader/gl_state.h>
+#include <shader/gl_resources.h>
+#include <shader/frame_pacer.h>
+#include <shader/latency.h>
+#include <shader/input_log.h>
+#include <shader/fixed_timestep.h>
+#include <shader/dynamic_resolution.h>
+#include <shader/frame_graph.h>
+#define ALLOC_TRACKER_IMPLEMENTATION
+#include <shader/alloc_tracker.h>
+#include <shader/frame_arena.h>
+#include <shader/pool_allocator.h>
+
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl_glfw.h"
+#include "imgui/imgui_impl_opengl3.h"
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <shader/camera.h>
+#include <shader/camera_path.h>
+#include <shader/quat_batch.h>
+
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void cursor_position_callback(GLFWwindow* window, double xpos, double ypos);
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+void char_callback(GLFWwindow* window, unsigned int c);
+void window_refresh_callback(GLFWwindow* window);
+void RequestRedraw();
+void processInput(GLFWwindow* window);
+glm::mat4 ShearTransform(glm::mat4 model, float SaX, float SaY, float SaZ);
+glm::mat4 Mirror(glm::mat4 model, float aXY, float aXZ, float aYZ);
+void DrawPerformanceOverlay(FrameArena& arena, const PoolAllocator& uiPool, const FramePacer& pacer, const FixedTimestep& simulation, const DynamicResolution& resolution,
+    const FrameGraph& graph);
+void PrintBenchmarkSummary(const FramePacer& pacer, const FixedTimestep& simulation, const DynamicResolution& resolution,
+    const FrameGraph& graph);
+bool QueryImGuiGLState(ImGui_ImplOpenGL3_State* state, void* userData);
+
+// settings
+const unsigned int SCR_WIDTH = 1920;
+const unsigned int SCR_HEIGHT = 1080;
+// texture memory limits, lower these for low-end machines
+const size_t TEXTURE_BUDGET_BYTES = 64 * 1024 * 1024;
+const int TEXTURE_MAX_SIZE = 2048;
+// upper limit for the instanced cube grid
+const int MAX_INSTANCES = 10000;
+
+// camera: at the origin looking down -z the view matrix is identity, so the scene keeps its framing
+Camera camera(glm::vec3(0.0f, 0.0f, 0.0f));
+float lastX = SCR_WIDTH / 2.0f;
+float lastY = SCR_HEIGHT / 2.0f;
+bool firstMouse = true;
+
+// timing
+float deltaTime = 0.0f;
+float lastFrame = 0.0f;
+
+// render on demand: frames still to draw before the loop may sleep. Input restarts the count because ImGui
+// needs a few frames to settle (hover highlights, windows that appear one frame late)
+const int REDRAW_FRAMES = 3;
+const double IDLE_WAIT_SECONDS = 0.5;
+int redrawFrames = REDRAW_FRAMES;
+
+// input recording and replay, the input callbacks write into it
+InputLog inputLog;
+
+// lighting
+glm::vec3 lightPos(1.f, 1.f, -5.f);
+
+// per instance data of the cube grid: object space offset + atlas layer, atlas UV rectangle
+struct InstanceData
+{
+    glm::vec4 OffsetLayer;
+    glm::vec4 UVRect;
+};
+void FillInstances(InstanceData* instances, int count, const std::vector<AtlasRegion>& regions);
+void FillSpinSteps(glm::quat* steps, int count, float stepSeconds);
+
+int main(int argc, char** argv)
+{
+    // command line: --trace <file> records a Chrome trace of the whole run (open it in ui.perfetto.dev),
+    // --check-allocations fails the exit code when a frame after the warm-up touched the heap (both need PROFILER_ENABLED),
+    // --frames-in-flight <1-3>, --fps-cap <fps> and --swap immediate|vsync|adaptive set the frame pacing,
+    // --latency-slo <ms> fails the exit code when the 99th percentile input-to-present latency is above it,
+    // --record <file> logs input and option edits, --replay <file> plays a log back at a fixed timestep and quits
+    // at its end, --headless hides the window during a replay,
+    // --camera-path <file> loads a camera path for the options window, --flythrough <file> flies it once at a fixed timestep
+    // as a benchmark and quits, --cubes <n> starts with n cubes (a fly-through defaults to the maximum),
+    // --sim-hz <hz> sets the rate of the fixed step simulation,
+    // --min-scale <s>, --max-scale <s> and --gpu-budget <ms> bound the dynamic resolution and set the GPU time it holds,
+    // --gpu-memory <MB> warns when the GL objects of the application hold more than that
+    // -------------------------------------------------------------------------------------------------
+    bool checkAllocations = false;
+    int framesInFlight = FRAME_PACER_FRAMES;
+    float fpsCap = 0.f;
+    int swapMode = SWAP_VSYNC;
+    double latencySlo = 0.0;
+    bool headless = false;
+    CameraPath cameraPath;
+    bool flythrough = false;
+    int startCubes = 0;
+    double simulationHz = SIMULATION_HZ;
+    float minScale = DYNAMIC_RESOLUTION_MIN_SCALE;
+    float maxScale = DYNAMIC_RESOLUTION_MAX_SCALE;
+    double gpuBudget = DYNAMIC_RESOLUTION_BUDGET_MS;
+    double gpuMemory = 0.0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+#ifdef PROFILER_ENABLED
+            if (!Tracer::Instance().Start(argv[++i]))
+                return -1;
+#else
+            std::cout << "ERROR::TRACE::PROFILER_DISABLED --trace needs a build with PROFILER_ENABLED" << std::endl;
+            return -1;
+#endif
+        }
+        else if (strcmp(argv[i], "--check-allocations") == 0)
+        {
+#ifdef PROFILER_ENABLED
+            checkAllocations = true;
+#else
+            std::cout << "ERROR::ALLOC::PROFILER_DISABLED --check-allocations needs a build with PROFILER_ENABLED" << std::endl;
+            return -1;
+#endif
+        }
+        else if (strcmp(argv[i], "--frames-in-flight") == 0 && i + 1 < argc)
+            framesInFlight = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fps-cap") == 0 && i + 1 < argc)
+            fpsCap = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+        {
+            if (!inputLog.Record(argv[++i]))
+                return -1;
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+        {
+            if (!inputLog.Replay(argv[++i]))
+                return -1;
+        }
+        else if (strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if ((strcmp(argv[i], "--camera-path") == 0 || strcmp(argv[i], "--flythrough") == 0) && i + 1 < argc)
+        {
+            flythrough = strcmp(argv[i], "--flythrough") == 0;
+            if (!cameraPath.Load(argv[++i]))
+                return -1;
+        }
+        else if (strcmp(argv[i], "--cubes") == 0 && i + 1 < argc)
+            startCubes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sim-hz") == 0 && i + 1 < argc)
+            simulationHz = atof(argv[++i]);
+        else if (strcmp(argv[i], "--min-scale") == 0 && i + 1 < argc)
+            minScale = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--max-scale") == 0 && i + 1 < argc)
+            maxScale = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--gpu-budget") == 0 && i + 1 < argc)
+            gpuBudget = atof(argv[++i]);
+        else if (strcmp(argv[i], "--gpu-memory") == 0 && i + 1 < argc)
+            gpuMemory = atof(argv[++i]);
+        else if (strcmp(argv[i], "--latency-slo") == 0 && i + 1 < argc)
+            latencySlo = atof(argv[++i]);
+        else if (strcmp(argv[i], "--swap") == 0 && i + 1 < argc)
+        {
+            swapMode = FramePacer::ParseSwapMode(argv[++i]);
+            if (swapMode < 0)
+            {
+                std::cout << "ERROR::FRAME_PACER::UNKNOWN_SWAP_MODE " << argv[i] << ", expected immediate, vsync or adaptive" << std::endl;
+                return -1;
+            }
+        }
+    }
+    TRACE_THREAD_NAME("Render");
+    ALLOC_TRACK_THIS_THREAD();
+
+    // glfw: initialize and configure
+    // ------------------------------
+    TRACE_PHASE("GLFW init");
+    glfwInit();
+    const char* glsl_version = "#version 130";
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    if (startCubes <= 0)
+        startCubes = flythrough ? MAX_INSTANCES : 1;
+    startCubes = std::min(startCubes, MAX_INSTANCES);
+    // a hidden window still renders every frame, GLFW has no context without one
+    if (headless && (inputLog.Replaying() || flythrough))
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    else if (headless)
+        std::cout << "ERROR::HEADLESS::NEEDS_REPLAY --headless only applies to --replay and --flythrough" << std::endl;
+
+    // glfw window creation
+    // --------------------
+    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "CG Cube", NULL, NULL);
+    if (window == NULL)
+    {
+        std::cout << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    // installed before ImGui, its backend chains to these
+    glfwSetCursorPosCallback(window, cursor_position_callback);
+    glfwSetMouseButtonCallback(window, mouse_button_callback);
+    glfwSetScrollCallback(window, scroll_callback);
+    glfwSetKeyCallback(window, key_callback);
+    glfwSetCharCallback(window, char_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
+
+    // glad: load all OpenGL function pointers
+    // ---------------------------------------
+    TRACE_PHASE("GLAD load");
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+
+    // configure global opengl state
+    // -----------------------------
+    // every per frame state change goes through the cache from here on, redundant ones never reach the driver
+    GLStateCache& glState = GLStateCache::Instance();
+    glState.Init();
+    glState.Enable(GL_DEPTH_TEST);
+    // every buffer, texture, vertex array, framebuffer and program is created through the registry, which keeps
+    // their memory by category and reports the ones never deleted at exit
+    GLResourceRegistry& resources = GLResourceRegistry::Instance();
+    resources.BudgetBytes = (size_t)(gpuMemory * 1024.0 * 1024.0);
+    GPU_PROFILE_INIT();
+    // frame pacing: how many frames the CPU may queue ahead of the GPU, frame rate cap and vsync
+    FramePacer pacer;
+    fpsCap = std::max(fpsCap, 0.f);
+    pacer.Init(framesInFlight, fpsCap, (FramePacer_SwapMode)swapMode);
+    framesInFlight = pacer.FramesInFlight;
+    swapMode = pacer.SwapMode;
+    // input-to-present latency, stamped in the input callbacks below
+    LatencyTracker& latency = LatencyTracker::Instance();
+    latency.Init();
+    // simulation clock: spinning cubes and the camera path move in fixed steps and are drawn between the last two
+    FixedTimestep simulation;
+    simulation.SetRate(simulationHz);
+
+    // build and compile our shader zprogram
+    // ------------------------------------
+    TRACE_PHASE("Shader compile");
+    Shader ourShader("Shaders/cube3d.vs", "Shaders/cube3d.fs");
+    Shader lightCubeShader("Shaders/2.2.light_cube.vs", "Shaders/2.2.light_cube.fs");
+    // the scene renders offscreen at a resolution that follows the GPU time, the UI stays at native resolution
+    DynamicResolution dynamicResolution("Shaders/upscale.vs", "Shaders/upscale.fs");
+    dynamicResolution.SetBounds(minScale, maxScale);
+    if (gpuBudget > 0.0)
+        dynamicResolution.BudgetMs = gpuBudget;
+    // offscreen targets come from one pool, passes that don't overlap in the frame share them
+    RenderTargetPool renderTargets;
+    FrameGraph frameGraph(renderTargets);
+
+    // set up vertex data (and buffer(s)) and configure vertex attributes
+    // ------------------------------------------------------------------
+    TRACE_PHASE("Geometry upload");
+    float vertices[] = {
+        //positions         //texture coords // color surfaces //normals
+        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
+         0.5f, -0.5f, -0.5f,  1.0f, 0.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
+         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
+         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
+        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,   1.f, 0.f, 0.f,  0.0f,  0.0f, -1.0f,
+
+        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
+         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
+         0.5f,  0.5f,  0.5f,  1.0f, 1.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
+         0.5f,  0.5f,  0.5f,  1.0f, 1.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
+        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
+        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.f, 1.f, 0.f,  0.0f,  0.0f,  1.0f,
+
+        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
+        -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
+        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
+        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.f, 0.f, 1.f,  -1.0f,  0.0f,  0.0f,
+
+         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
+         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
+         0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
+         0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
+         0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   1.f, 1.f, 0.f,  1.0f,  0.0f,  0.0f,
+
+        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
+         0.5f, -0.5f, -0.5f,  1.0f, 1.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
+         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
+         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
+        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.f, 0.f, 1.f,  0.0f, -1.0f,  0.0f,
+
+        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
+         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
+        -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f,
+        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   0.f, 1.f, 1.f,  0.0f,  1.0f,  0.0f
+    };
+    //first configure the cube's VAO and VBO
+    GLHandle cubeVertexArray = resources.Create(RESOURCE_VERTEX_ARRAY, "Cube");
+    GLHandle cubeVertexBuffer = resources.Create(RESOURCE_BUFFER, "Cube vertices");
+    unsigned int VAO = resources.Name(cubeVertexArray);
+    unsigned int VBO = resources.Name(cubeVertexBuffer);
+
+    glState.BindVertexArray(VAO);
+
+    glState.BindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    resources.SetBytes(cubeVertexBuffer, sizeof(vertices));
+
+    // position attribute
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    // texture coord attribute
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    // color surface attribute
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(5 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    // normal attribute
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(8 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+
+    // second, configure the light's VAO (VBO stays the same; the vertices are the same for the light object which is also a 3D cube)
+    GLHandle lightCubeVertexArray = resources.Create(RESOURCE_VERTEX_ARRAY, "Light cube");
+    unsigned int lightCubeVAO = resources.Name(lightCubeVertexArray);
+    glState.BindVertexArray(lightCubeVAO);
+
+    glState.BindBuffer(GL_ARRAY_BUFFER, VBO);
+    // note that we update the lamp's position attribute's stride to reflect the updated buffer data
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // load and create a texture 
+    // -------------------------
+    TRACE_PHASE("Texture load");
+    TextureManager textureManager(TEXTURE_BUDGET_BYTES, TEXTURE_MAX_SIZE);
+    stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
+    // every texture of the scene is packed into the layers of one array texture, so drawing never rebinds
+    TextureAtlas atlas(TEXTURE_MAX_SIZE);
+    // texture 1
+    // ---------
+    int matrixRegion = -1;
+    {
+        Image image; // the atlas keeps its own copy until the upload
+        if (textureManager.Decode("textures/matrix.jpg", image))
+        {
+            matrixRegion = atlas.Add(image);
+        }
+        else
+        {
+            std::cout << "Failed to load texture" << std::endl;
+        }
+    }
+    // the atlas halves its largest images itself when it doesn't fit into what is left of the budget
+    atlas.Build(textureManager.AvailableBytes());
+    textureManager.Reserve(atlas.Bytes());
+
+    // instance buffer of the cube grid, a single instance sits at the origin like the old single cube
+    std::vector<InstanceData> instances(MAX_INSTANCES);
+    FillInstances(instances.data(), 1, atlas.Regions());
+    GLHandle instanceBuffer = resources.Create(RESOURCE_BUFFER, "Instances");
+    unsigned int instanceVBO = resources.Name(instanceBuffer);
+    glState.BindVertexArray(VAO);
+    glState.BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, MAX_INSTANCES * sizeof(InstanceData), instances.data(), GL_STATIC_DRAW);
+    resources.SetBytes(instanceBuffer, MAX_INSTANCES * sizeof(InstanceData));
+    // instance offset + layer attribute
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)0);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+    // instance atlas rectangle attribute
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, UVRect));
+    glEnableVertexAttribArray(5);
+    glVertexAttribDivisor(5, 1);
+    int instanceCount = 1;
+
+    // per instance rotation of the spinning cubes. Orientations advance by a step quaternion built once per cube
+    // and go through the batch kernel into the rotation buffer only while they change
+    std::vector<glm::quat> spins(MAX_INSTANCES);
+    std::vector<glm::quat> previousSpins(MAX_INSTANCES);   // one simulation step back, for the interpolation
+    std::vector<glm::quat> drawnSpins(MAX_INSTANCES);
+    std::vector<glm::quat> spinSteps(MAX_INSTANCES);
+    std::vector<InstanceRotation> rotations(MAX_INSTANCES);
+    FillSpinSteps(spinSteps.data(), MAX_INSTANCES, (float)simulation.Step);
+    QuatBatch::ToMatrices(spins.data(), rotations.data(), MAX_INSTANCES);
+    QuatBatch spinBatch;
+    int spinReset = 0;
+    GLHandle rotationBuffer = resources.Create(RESOURCE_BUFFER, "Instance rotations");
+    unsigned int rotationVBO = resources.Name(rotationBuffer);
+    glState.BindBuffer(GL_ARRAY_BUFFER, rotationVBO);
+    glBufferData(GL_ARRAY_BUFFER, MAX_INSTANCES * sizeof(InstanceRotation), rotations.data(), GL_DYNAMIC_DRAW);
+    resources.SetBytes(rotationBuffer, MAX_INSTANCES * sizeof(InstanceRotation));
+    // instance rotation attribute, a mat3 takes one location per column
+    for (int column = 0; column < 3; column++) {
+        glVertexAttribPointer(6 + column, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceRotation), (void*)(column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(6 + column);
+        glVertexAttribDivisor(6 + column, 1);
+    }
+
+    // rotation of the whole grid, rebuilt from a quaternion only when the angles change
+    glm::vec3 rotationAngles(0.f);
+    glm::mat4 rotationMatrix(1.f);
+
+    // procedural textures: generated on the GPU, an alternative to the decoded images
+    // -------------------------------------------------------------------------------
+    TRACE_PHASE("Procedural textures");
+    ProceduralTexture procedural("Shaders/procedural.vs", "Shaders/procedural.fs");
+    procedural.Resize(PROCEDURAL_SIZE);
+    textureManager.Reserve(procedural.Bytes());
+    int maxTextureSize;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    bool proceduralDirty = true;
+    unsigned int proceduralProgram = 0; // program of the last render, a hot reload makes it stale
+    int instanceSource = 0;
+
+    // hot reload: rebuild shaders and textures when their files change on disk
+    // ------------------------------------------------------------------------
+    TRACE_PHASE("Hot reload setup");
+    HotReloader hotReloader(textureManager);
+    hotReloader.WatchShader(ourShader);
+    hotReloader.WatchShader(lightCubeShader);
+    hotReloader.WatchShader(procedural.Program);
+    hotReloader.WatchShader(dynamicResolution.Program);
+    hotReloader.WatchTexture("textures/matrix.jpg", [&](const Image& reloaded)
+    {
+        bool repack = true;
+        if (matrixRegion < 0)
+            matrixRegion = atlas.Add(reloaded);
+        else
+            repack = !atlas.Update(matrixRegion, reloaded);
+        if (repack)
+        {
+            textureManager.Unreserve(atlas.Bytes());
+            atlas.Build(textureManager.AvailableBytes());
+            textureManager.Reserve(atlas.Bytes());
+            instanceCount = 0; // the regions moved, refill the instance buffer
+        }
+    });
+    hotReloader.OnPending = []() { glfwPostEmptyEvent(); };
+    hotReloader.Start();
+   
+
+    // tell opengl for each sampler to which texture unit it belongs to (only has to be done once)
+    // -------------------------------------------------------------------------------------------
+    ourShader.use();
+    ourShader.setInt("texture1", 0);
+    
+    // Setup Dear ImGui context
+    TRACE_PHASE("ImGui init");
+    IMGUI_CHECKVERSION();
+    // everything ImGui keeps comes out of one reserved pool, outliving the context
+    PoolAllocator uiPool;
+    ImGui::SetAllocatorFunctions(PoolAllocator::AllocFunc, PoolAllocator::FreeFunc, &uiPool);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO(); (void)io;
+    //io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
+    //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
+    if (inputLog.Replaying())
+        io.ConfigFlags |= ImGuiConfigFlags_NoMouse;             // the replay drives the options, not the mouse
+
+    // Load fonts: the baked atlas comes from the disk cache, stb_truetype only runs when the fonts changed
+    io.Fonts->AddFontDefault();
+    FontCache fontCache;
+    if (!fontCache.Load(*io.Fonts))
+    {
+        io.Fonts->Build();
+        fontCache.Save(*io.Fonts);
+    }
+
+    // Setup Dear ImGui style
+    //ImGui::StyleColorsDark();
+    ImGui::StyleColorsClassic();
+    //ImGui::StyleColorsLight();
+    // Setup Platform/Renderer backends
+    ImGui_ImplGlfw_InitForOpenGL(window, true);
+    ImGui_ImplOpenGL3_Init(glsl_version);
+    // the backend backs up and restores its state every frame, let it read the cache instead of glGet
+    ImGui_ImplOpenGL3_SetStateQuery(QueryImGuiGLState, &glState);
+
+    
+    ImVec4 clear_color = ImVec4(1.f, 0.1f, 0.2f, 1.00f);
+    // transient per frame data, released at the top of every frame
+    FrameArena frameArena;
+    TRACE_PHASE(nullptr);
+
+
+    // render loop
+    // -----------
+    while (!glfwWindowShouldClose(window))
+    {
+        PROFILE_BEGIN_FRAME();
+        PROFILE_STAGE(PROFILE_PACING);
+        pacer.BeginFrame();
+        GPU_PROFILE_BEGIN_FRAME();
+        ALLOC_BEGIN_FRAME();
+        frameArena.Reset();
+
+        // per-frame time logic
+        // --------------------
+        float currentFrame = inputLog.Replaying() ? inputLog.Time() : (float)glfwGetTime();
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        // swap in shaders/textures that were rebuilt since the last frame
+        hotReloader.Update();
+
+        // input
+        // -----
+        // polled after the pacing wait so the frame starts from the freshest input
+        PROFILE_STAGE(PROFILE_INPUT);
+        glfwPollEvents();
+        InputEvent replayed;
+        while (inputLog.NextEvent(replayed))
+        {
+            LatencyTracker::Instance().Input();
+            if (replayed.Kind == INPUT_KEY && replayed.Key == GLFW_KEY_ESCAPE && replayed.Action == GLFW_PRESS)
+                glfwSetWindowShouldClose(window, true);
+        }
+        processInput(window);
+        latency.BeginFrame();
+        // Start the Dear ImGui frame
+        PROFILE_STAGE(PROFILE_UI_BUILD);
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+        ImGui::NewFrame();
+        
+        
+        // 2. Show a simple window that we create ourselves. We use a Begin/End pair to created a named window
+        
+        //current value holders
+        static float TRANSLATE_X = 0.0f;
+        static float TRANSLATE_Y = 0.0f;
+        static float TRANSLATE_Z = 0.0f;
+
+        static float ROTATE_X = 0.0f;
+        static float ROTATE_Y = 0.0f;
+        static float ROTATE_Z = 0.0f;
+        static float RP_X = 0.0f;
+        static float RP_Y = 0.0f;
+        static float RP_Z = 0.0f;
+
+        static float SCALE_X = 1.0f;
+        static float SCALE_Y = 1.0f;
+        static float SCALE_Z = 1.0f;
+        static float Sk = 1.0f;
+
+        static bool  ASPECT_RATIO = true;
+        static bool ROTATE_ENABLE = false;
+        static bool TRANSLATE_ENABLE = false;
+        static bool SCALE_ENABLE = false;
+        static bool PERSPECTIVE_ENABLE = true;
+        static bool WIREFRAME = false;
+        static bool TEX_ENABLE = true;
+        static bool SHEAR_ENABLE = false;
+        static bool MIRROR_ENABLE = false;
+
+        static bool SaX_ENABLE = false;
+        static bool SaY_ENABLE = false;
+        static bool SaZ_ENABLE = false;
+
+        static bool mXY_ENABLE = false;
+        static bool mXZ_ENABLE = false;
+        static bool mYZ_ENABLE = false;
+
+        static int INSTANCES = startCubes;
+        static bool SPIN_CUBES = false;
+        static int spinResets = 0;  // counts the resets, so a replay puts the cubes back upright at the same frame
+
+        static int TEX_SOURCE = 0; // 0 image atlas, 1 procedural
+        static int PROC_SIZE = 2;  // 256 << PROC_SIZE
+        static float PROC_SCALE = PROCEDURAL_SCALE;
+        static bool PROC_ANIMATE = false;
+
+        static bool RENDER_ON_DEMAND = true;
+        static bool PERF_OVERLAY = false;
+        static bool CAMERA_PATH = flythrough;
+        static long long pathStep = 0;
+
+        static bool DYNAMIC_RESOLUTION = true;
+        static int UPSCALE_FILTER = UPSCALE_BILINEAR;
+        static float SHARPNESS = DYNAMIC_RESOLUTION_SHARPNESS;
+
+        static int SWAP_MODE = swapMode;
+        static int FRAMES_IN_FLIGHT = framesInFlight;
+        static float FPS_CAP = fpsCap;
+
+        //past value holders
+        static float tra_x = 0.f;
+        static float tra_y = 0.f;
+        static float tra_z = 0.f;
+
+        static float rot_x = 0.f;
+        static float rot_y = 0.f;
+        static float rot_z = 0.f;
+
+        static float rp_x = 0.0f;
+        static float rp_y = 0.0f;
+        static float rp_z = 0.0f;
+
+        static float sca_x = 1.f;
+        static float sca_y = 1.f;
+        static float sca_z = 1.f;
+
+        static float past_sax = 0.f;
+        static float past_say = 0.f;
+        static float past_saz = 0.f;
+
+        static float past_mxy = 0.f;
+        static float past_mxz = 0.f;
+        static float past_myz = 0.f;
+        
+        static float Lx = 0.0f;
+        static float Ly = 0.0f;
+        static float Lz = -5.f;
+
+        // every value the options window changes, by name, so a recording can drive them
+        if (!inputLog.Bound()) {
+            inputLog.Bind("TRANSLATE_X", &TRANSLATE_X); inputLog.Bind("TRANSLATE_Y", &TRANSLATE_Y); inputLog.Bind("TRANSLATE_Z", &TRANSLATE_Z);
+            inputLog.Bind("ROTATE_X", &ROTATE_X); inputLog.Bind("ROTATE_Y", &ROTATE_Y); inputLog.Bind("ROTATE_Z", &ROTATE_Z);
+            inputLog.Bind("RP_X", &RP_X); inputLog.Bind("RP_Y", &RP_Y); inputLog.Bind("RP_Z", &RP_Z);
+            inputLog.Bind("SCALE_X", &SCALE_X); inputLog.Bind("SCALE_Y", &SCALE_Y); inputLog.Bind("SCALE_Z", &SCALE_Z); inputLog.Bind("Sk", &Sk);
+
+            inputLog.Bind("ASPECT_RATIO", &ASPECT_RATIO); inputLog.Bind("ROTATE_ENABLE", &ROTATE_ENABLE);
+            inputLog.Bind("TRANSLATE_ENABLE", &TRANSLATE_ENABLE); inputLog.Bind("SCALE_ENABLE", &SCALE_ENABLE);
+            inputLog.Bind("PERSPECTIVE_ENABLE", &PERSPECTIVE_ENABLE); inputLog.Bind("WIREFRAME", &WIREFRAME); inputLog.Bind("TEX_ENABLE", &TEX_ENABLE);
+            inputLog.Bind("SHEAR_ENABLE", &SHEAR_ENABLE); inputLog.Bind("MIRROR_ENABLE", &MIRROR_ENABLE);
+            inputLog.Bind("SaX_ENABLE", &SaX_ENABLE); inputLog.Bind("SaY_ENABLE", &SaY_ENABLE); inputLog.Bind("SaZ_ENABLE", &SaZ_ENABLE);
+            inputLog.Bind("mXY_ENABLE", &mXY_ENABLE); inputLog.Bind("mXZ_ENABLE", &mXZ_ENABLE); inputLog.Bind("mYZ_ENABLE", &mYZ_ENABLE);
+
+            inputLog.Bind("INSTANCES", &INSTANCES); inputLog.Bind("SPIN_CUBES", &SPIN_CUBES); inputLog.Bind("spinResets", &spinResets);
+            inputLog.Bind("TEX_SOURCE", &TEX_SOURCE); inputLog.Bind("PROC_SIZE", &PROC_SIZE);
+            inputLog.Bind("PROC_SCALE", &PROC_SCALE); inputLog.Bind("PROC_ANIMATE", &PROC_ANIMATE);
+            inputLog.Bind("PERF_OVERLAY", &PERF_OVERLAY); inputLog.Bind("CAMERA_PATH", &CAMERA_PATH);
+            inputLog.Bind("DYNAMIC_RESOLUTION", &DYNAMIC_RESOLUTION); inputLog.Bind("UPSCALE_FILTER", &UPSCALE_FILTER); inputLog.Bind("SHARPNESS", &SHARPNESS);
+
+            // the past value holders too, the Reset button sets them directly
+            inputLog.Bind("tra_x", &tra_x); inputLog.Bind("tra_y", &tra_y); inputLog.Bind("tra_z", &tra_z);
+            inputLog.Bind("rot_x", &rot_x); inputLog.Bind("rot_y", &rot_y); inputLog.Bind("rot_z", &rot_z);
+            inputLog.Bind("rp_x", &rp_x); inputLog.Bind("rp_y", &rp_y); inputLog.Bind("rp_z", &rp_z);
+            inputLog.Bind("sca_x", &sca_x); inputLog.Bind("sca_y", &sca_y); inputLog.Bind("sca_z", &sca_z);
+            inputLog.Bind("past_sax", &past_sax); inputLog.Bind("past_say", &past_say); inputLog.Bind("past_saz", &past_saz);
+            inputLog.Bind("past_mxy", &past_mxy); inputLog.Bind("past_mxz", &past_mxz); inputLog.Bind("past_myz", &past_myz);
+
+            inputLog.Bind("Lx", &Lx); inputLog.Bind("Ly", &Ly); inputLog.Bind("Lz", &Lz);
+        }
+
+        glState.PolygonMode(WIREFRAME ? GL_LINE : GL_FILL);
+
+        ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
+        ImGui::Begin("Options");                          // Create a window called "Hello, world!" and append into it.
+        
+
+        // TRANSLATE
+        ImGui::Text("Translation");
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Tx", &TRANSLATE_X, .1f, 1.0f, "%.3f");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Ty", &TRANSLATE_Y, .1f, 1.0f, "%.3f");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Tz", &TRANSLATE_Z, .1f, 1.0f, "%.3f");
+        ImGui::SameLine();
+
+        if (ImGui::Button("Translate"))
+            TRANSLATE_ENABLE = true;
+        
+        // ROTATE by Angle
+        ImGui::Text("Rotation");
+        ImGui::Text("Angle"); ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Rx", &ROTATE_X, 1.f, 1.0f, "%.3f");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Ry", &ROTATE_Y, 1.f, 1.0f, "%.3f");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Rz", &ROTATE_Z, 1.f, 1.0f, "%.3f");
+
+        //ROTATE by point
+        ImGui::Text("Point"); ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("PRx", &RP_X, 1.f, 1.0f, "%.3f");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("PRy", &RP_Y, 1.f, 1.0f, "%.3f");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("PRz", &RP_Z, 1.f, 1.0f, "%.3f");
+        ImGui::SameLine();
+
+        if (ImGui::Button("Rotate"))
+            ROTATE_ENABLE = true;
+
+        // SCALE
+        if (ASPECT_RATIO) {
+            ImGui::Text("Scaling");
+            ImGui::SetNextItemWidth(100);
+            ImGui::InputFloat("Sx", &Sk, 0.1f, 1.0f, "%.3f");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(100);
+            ImGui::InputFloat("Sy", &Sk, 0.1f, 1.0f, "%.3f");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(100);
+            ImGui::InputFloat("Sz", &Sk, .1f, 1.0f, "%.3f");
+            ImGui::SameLine();
+        }
+
+        else {
+            ImGui::Text("Scaling");
+            ImGui::SetNextItemWidth(100);
+            ImGui::InputFloat("Sx", &SCALE_X, .1f, 1.0f, "%.3f");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(100);
+            ImGui::InputFloat("Sy", &SCALE_Y, .1f, 1.0f, "%.3f");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(100);
+            ImGui::InputFloat("Sz", &SCALE_Z, .1f, 1.0f, "%.3f");
+            ImGui::SameLine();
+        }
+
+        if (ImGui::Button("Scale"))
+            SCALE_ENABLE = true;
+
+        if (ImGui::Button("Reset"))
+        {
+             TRANSLATE_X = 0.0f;
+             TRANSLATE_Y = 0.0f;
+             TRANSLATE_Z = 0.0f;
+
+             ROTATE_X = 0.0f;
+             ROTATE_Y = 0.0f;
+             ROTATE_Z = 0.0f;
+             RP_X = 0.0f;
+             RP_Y = 0.0f;
+             RP_Z = 0.0f;
+
+             SCALE_X = 1.0f;
+             SCALE_Y = 1.0f;
+             SCALE_Z = 1.0f;
+             Sk = 1.0f;
+
+             ASPECT_RATIO = true;
+             ROTATE_ENABLE = false;
+             TRANSLATE_ENABLE = false;
+             SCALE_ENABLE = false;
+             PERSPECTIVE_ENABLE = true;
+             WIREFRAME = false;
+             TEX_ENABLE = true;
+             SHEAR_ENABLE = false;
+             MIRROR_ENABLE = false;
+             
+             SaX_ENABLE = false;
+             SaY_ENABLE = false;
+             SaZ_ENABLE = false;
+
+             mXY_ENABLE = false;
+             mXZ_ENABLE = false;
+             mYZ_ENABLE = false;
+
+             INSTANCES = startCubes;
+             SPIN_CUBES = false;
+             spinResets++;
+
+             TEX_SOURCE = 0;
+             PROC_SIZE = 2;
+             PROC_SCALE = PROCEDURAL_SCALE;
+             PROC_ANIMATE = false;
+
+             RENDER_ON_DEMAND = true;
+             PERF_OVERLAY = false;
+             CAMERA_PATH = flythrough;
+             pathStep = 0;
+             camera.LookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f));
+
+             DYNAMIC_RESOLUTION = true;
+             UPSCALE_FILTER = UPSCALE_BILINEAR;
+             SHARPNESS = DYNAMIC_RESOLUTION_SHARPNESS;
+
+             SWAP_MODE = swapMode;
+             FRAMES_IN_FLIGHT = framesInFlight;
+             FPS_CAP = fpsCap;
+            //past value holders
+             tra_x = 0.f;
+             tra_y = 0.f;
+             tra_z = 0.f;
+
+             rot_x = 0.f;
+             rot_y = 0.f;
+             rot_z = 0.f;
+
+             rp_x = 0.f;
+             rp_y = 0.f;
+             rp_z = 0.f;
+
+             sca_x = 1.f;
+             sca_y = 1.f;
+             sca_z = 1.f;
+
+             past_sax = 0.f;
+             past_say = 0.f;
+             past_saz = 0.f;
+
+             past_mxy = 0.f;
+             past_mxz = 0.f;
+             past_myz = 0.f;
+        }
+
+        ImGui::Checkbox("Keep Aspect Ratio", &ASPECT_RATIO);
+        ImGui::Checkbox("Perspective/Ortho", &PERSPECTIVE_ENABLE);
+        ImGui::Checkbox("Fill/Wireframe", &WIREFRAME);
+        ImGui::Checkbox("Texture ON/OFF", &TEX_ENABLE);
+        ImGui::SetNextItemWidth(200);
+        ImGui::SliderInt("Cubes", &INSTANCES, 1, MAX_INSTANCES);
+        ImGui::SameLine();
+        ImGui::Checkbox("Spin", &SPIN_CUBES);
+
+        //Texture source
+        ImGui::RadioButton("Image", &TEX_SOURCE, 0); ImGui::SameLine();
+        ImGui::RadioButton("Procedural", &TEX_SOURCE, 1);
+        if (TEX_SOURCE == 1) {
+            const char* sizes[] = { "256", "512", "1024", "2048", "4096", "8192", "16384" };
+            // only sizes the GPU supports and the texture budget still holds, the current texture's share included
+            size_t proceduralBudget = textureManager.AvailableBytes() + procedural.Bytes();
+            int sizeCount = 1;
+            while (sizeCount < IM_ARRAYSIZE(sizes) && (256 << sizeCount) <= maxTextureSize && ProceduralTexture::BytesFor(256 << sizeCount) <= proceduralBudget)
+                sizeCount++;
+            ImGui::SetNextItemWidth(100);
+            ImGui::Combo("Size", &PROC_SIZE, sizes, sizeCount);
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(100);
+            ImGui::SliderFloat("Pattern scale", &PROC_SCALE, 1.f, 64.f, "%.1f");
+            ImGui::SameLine();
+            ImGui::Checkbox("Animate", &PROC_ANIMATE);
+        }
+        ImGui::Text("Texture memory %.1f / %.1f MB", textureManager.UsedBytes() / (1024.f * 1024.f), textureManager.BudgetBytes / (1024.f * 1024.f));
+        ImGui::Checkbox("Render on demand", &RENDER_ON_DEMAND);
+        ImGui::SameLine();
+        ImGui::Checkbox("Performance overlay", &PERF_OVERLAY);
+        if (cameraPath.Loaded()) {
+            ImGui::SameLine();
+            ImGui::Checkbox("Camera path", &CAMERA_PATH);
+            ImGui::SameLine();
+            ImGui::Text("%.1f / %.1f s", pathStep * simulation.Step, cameraPath.Duration());
+        }
+
+        //Dynamic resolution: the scene drops resolution to stay within the GPU budget
+        ImGui::Checkbox("Dynamic resolution", &DYNAMIC_RESOLUTION);
+        if (DYNAMIC_RESOLUTION) {
+            const char* filters[UPSCALE_FILTER_COUNT] = { DynamicResolution::FilterName(UPSCALE_BILINEAR), DynamicResolution::FilterName(UPSCALE_SHARPEN) };
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(100);
+            ImGui::Combo("Upscale", &UPSCALE_FILTER, filters, UPSCALE_FILTER_COUNT);
+            if (UPSCALE_FILTER == UPSCALE_SHARPEN) {
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(100);
+                ImGui::SliderFloat("Sharpness", &SHARPNESS, 0.f, 1.f, "%.2f");
+            }
+            ImGui::SameLine();
+            ImGui::Text("%.0f%% %dx%d", dynamicResolution.Scale * 100.f, dynamicResolution.Width, dynamicResolution.Height);
+        }
+
+        //Frame pacing: fewer frames in flight lower the input latency, more keep the GPU busy
+        const char* swapModes[SWAP_MODE_COUNT] = { FramePacer::SwapModeName(SWAP_IMMEDIATE), FramePacer::SwapModeName(SWAP_VSYNC), FramePacer::SwapModeName(SWAP_ADAPTIVE) };
+        ImGui::SetNextItemWidth(100);
+        ImGui::Combo("Swap", &SWAP_MODE, swapModes, pacer.AdaptiveSupported ? SWAP_MODE_COUNT : SWAP_ADAPTIVE);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::SliderInt("Frames in flight", &FRAMES_IN_FLIGHT, 1, FRAME_PACER_MAX_FRAMES);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::SliderFloat("FPS cap", &FPS_CAP, 0.f, 240.f, FPS_CAP > 0.f ? "%.0f" : "off");
+        if (SWAP_MODE != pacer.SwapMode) {
+            pacer.SetSwapMode((FramePacer_SwapMode)SWAP_MODE);
+            SWAP_MODE = pacer.SwapMode;
+        }
+        pacer.SetFramesInFlight(FRAMES_IN_FLIGHT);
+        pacer.TargetFps = FPS_CAP;
+
+        if (ImGui::Button("Shear")) {
+            SHEAR_ENABLE = true;
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("X", &SaX_ENABLE); ImGui::SameLine();
+        ImGui::Checkbox("Y", &SaY_ENABLE); ImGui::SameLine();
+        ImGui::Checkbox("Z", &SaZ_ENABLE); 
+
+        if (ImGui::Button("Mirror")) {
+            MIRROR_ENABLE = true;
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("XY", &mXY_ENABLE); ImGui::SameLine();
+        ImGui::Checkbox("XZ", &mXZ_ENABLE); ImGui::SameLine();
+        ImGui::Checkbox("YZ", &mYZ_ENABLE);
+
+        //Light bulb position
+        ImGui::Text("Bulb"); ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Lx", &Lx, 1.f, 1.0f, "%.3f");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Ly", &Ly, 1.f, 1.0f, "%.3f");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputFloat("Lz", &Lz, 1.f, 1.0f, "%.3f");
+        ImGui::SameLine();
+
+        ImGui::End();
+
+        // record the edits of this frame, or replace them with the recorded ones
+        inputLog.Update();
+        // a replayed log writes the options directly, past the widgets: keep them in the ranges the widgets allow
+        INSTANCES = std::max(std::min(INSTANCES, MAX_INSTANCES), 1);
+        TEX_SOURCE = std::max(std::min(TEX_SOURCE, 1), 0);
+        PROC_SIZE = std::max(std::min(PROC_SIZE, 6), 0);    // 256 to 16384, the entries of the Size combo
+        UPSCALE_FILTER = std::max(std::min(UPSCALE_FILTER, UPSCALE_FILTER_COUNT - 1), 0);
+
+        if (PERF_OVERLAY)
+            DrawPerformanceOverlay(frameArena, uiPool, pacer, simulation, dynamicResolution, frameGraph);
+
+        // render
+        // ------
+        PROFILE_STAGE(PROFILE_SCENE_DRAW);
+        // the scene goes into an offscreen target at this frame's scale, the projection follows the real window size
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        framebufferWidth = std::max(framebufferWidth, 1);
+        framebufferHeight = std::max(framebufferHeight, 1);
+        dynamicResolution.Enabled = DYNAMIC_RESOLUTION;
+        dynamicResolution.Filter = UPSCALE_FILTER;
+        dynamicResolution.Sharpness = SHARPNESS;
+        dynamicResolution.BeginFrame(framebufferWidth, framebufferHeight);
+        // passes of this frame and what they read and write. Unscaled, the scene goes straight to the window
+        frameGraph.Reset(framebufferWidth, framebufferHeight);
+        int backbuffer = frameGraph.Backbuffer();
+        int scenePass = frameGraph.AddPass("Scene");
+        int upscalePass = -1;
+        int sceneColor = -1;
+        if (dynamicResolution.Enabled) {
+            sceneColor = frameGraph.CreateTexture("Scene color", GL_RGBA8, dynamicResolution.TargetWidth, dynamicResolution.TargetHeight);
+            int sceneDepth = frameGraph.CreateRenderbuffer("Scene depth", GL_DEPTH24_STENCIL8, dynamicResolution.TargetWidth, dynamicResolution.TargetHeight);
+            frameGraph.Write(scenePass, sceneColor);
+            frameGraph.Write(scenePass, sceneDepth);
+            upscalePass = frameGraph.AddPass("Upscale");
+            frameGraph.Read(upscalePass, sceneColor);
+            frameGraph.Write(upscalePass, backbuffer);
+        }
+        else
+            frameGraph.Write(scenePass, backbuffer);
+        int uiPass = frameGraph.AddPass("UI");
+        frameGraph.Write(uiPass, backbuffer);
+        frameGraph.Compile();
+        frameGraph.BeginPass(scenePass);
+        if (frameGraph.Fallback)
+            dynamicResolution.Enabled = false; // no usable target, the scene went to the window at full size
+        else
+            glState.Viewport(0, 0, dynamicResolution.Width, dynamicResolution.Height);
+        DYNAMIC_RESOLUTION = dynamicResolution.Enabled;
+        glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // also clear the depth buffer now!
+        
+
+        // procedural textures: re-render only when a parameter changed, or every frame while animated
+        if (TEX_SOURCE == 1) {
+            if ((256 << PROC_SIZE) != procedural.Size) {
+                textureManager.Unreserve(procedural.Bytes());
+                // a replayed size may be over the budget, and the driver may still run out of memory
+                if (ProceduralTexture::BytesFor(256 << PROC_SIZE) > textureManager.AvailableBytes() || !procedural.Resize(256 << PROC_SIZE)) {
+                    PROC_SIZE = 0;
+                    while ((256 << PROC_SIZE) < procedural.Size)
+                        PROC_SIZE++;
+                }
+                textureManager.Reserve(procedural.Bytes());
+                proceduralDirty = true;
+            }
+            if (PROC_SCALE != procedural.Scale) {
+                procedural.Scale = PROC_SCALE;
+                proceduralDirty = true;
+            }
+            if (proceduralDirty || PROC_ANIMATE || procedural.Program.ID != proceduralProgram) {
+                procedural.Render(currentFrame);
+                proceduralDirty = false;
+                proceduralProgram = procedural.Program.ID;
+            }
+        }
+
+        // bind textures on corresponding texture units
+        glState.ActiveTexture(GL_TEXTURE0);
+        if (TEX_ENABLE) {
+            glState.BindTexture(GL_TEXTURE_2D_ARRAY, TEX_SOURCE == 1 ? procedural.ID : atlas.ID);
+        }
+        else {
+            glState.BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        }
+
+        // rebuild the instance grid only when the cube count or the texture source changed
+        if (INSTANCES != instanceCount || TEX_SOURCE != instanceSource) {
+            instanceCount = INSTANCES;
+            instanceSource = TEX_SOURCE;
+            FillInstances(instances.data(), instanceCount, TEX_SOURCE == 1 ? procedural.Regions() : atlas.Regions());
+            glState.BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, instanceCount * sizeof(InstanceData), instances.data());
+        }
+
+        // activate shader
+        ourShader.use();
+
+        // simulation: the whole steps the time of this frame adds up to. Replays and fly-throughs hand in fixed frame
+        // times, so they take the same steps on every run; a slow frame runs several, a fast one may run none
+        PROFILE_STAGE(PROFILE_SIMULATION);
+        double frameSeconds = inputLog.Replaying() ? INPUT_LOG_TIMESTEP : flythrough ? simulation.Step : deltaTime;
+        int steps = simulation.Advance(frameSeconds);
+        if (spinResets != spinReset) {
+            std::fill(spins.begin(), spins.end(), glm::quat(1.f, 0.f, 0.f, 0.f));
+            std::fill(previousSpins.begin(), previousSpins.end(), glm::quat(1.f, 0.f, 0.f, 0.f));
+            spinBatch.Reset();
+            QuatBatch::ToMatrices(spins.data(), rotations.data(), MAX_INSTANCES);
+            glState.BindBuffer(GL_ARRAY_BUFFER, rotationVBO);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, MAX_INSTANCES * sizeof(InstanceRotation), rotations.data());
+            spinReset = spinResets;
+        }
+        for (int step = 0; step < steps; step++) {
+            if (CAMERA_PATH && cameraPath.Loaded())
+                pathStep++;
+            if (SPIN_CUBES) {
+                // the interpolation only needs where the last step started
+                if (step == steps - 1)
+                    std::copy(spins.begin(), spins.begin() + instanceCount, previousSpins.begin());
+                spinBatch.Integrate(spins.data(), spinSteps.data(), instanceCount);
+            }
+        }
+
+        // create transformations
+        PROFILE_STAGE(PROFILE_TRANSFORMS);
+        glm::mat4 model = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
+        glm::mat4 projection = glm::mat4(1.0f);
+
+        // camera path: drawn between the last two simulation steps. A fly-through ends the program after the last key,
+        // otherwise the path loops
+        if (CAMERA_PATH && cameraPath.Loaded()) {
+            float pathTime = (float)((pathStep - 1 + simulation.Alpha) * simulation.Step);
+            glm::vec3 eye, target;
+            cameraPath.Sample(pathTime, eye, target);
+            camera.LookAt(eye, target);
+            if (pathTime >= cameraPath.Duration()) {
+                if (flythrough)
+                    glfwSetWindowShouldClose(window, true);
+                pathStep = 0;
+            }
+        }
+        glm::mat4 view = camera.GetViewMatrix();
+        
+
+        
+        //Translate
+        if (TRANSLATE_ENABLE) {
+            model = glm::translate(model, glm::vec3(TRANSLATE_X, TRANSLATE_Y, TRANSLATE_Z-3.f));
+
+            tra_x = TRANSLATE_X;
+            tra_y = TRANSLATE_Y;
+            tra_z = TRANSLATE_Z;
+
+            TRANSLATE_ENABLE = false;
+        }
+
+        else 
+        {
+            model = glm::translate(model, glm::vec3(tra_x, tra_y, tra_z-3.f));
+        }
+        
+        // Rotate by angle
+        if (ROTATE_ENABLE) {
+            rot_x = ROTATE_X;
+            rot_y = ROTATE_Y;
+            rot_z = ROTATE_Z;
+
+            rp_x = RP_X;
+            rp_y = RP_Y;
+            rp_z = RP_Z;
+
+            ROTATE_ENABLE = false;
+        }
+        // x, then y, then z as one quaternion; its matrix stays cached until the angles change
+        if (rot_x != rotationAngles.x || rot_y != rotationAngles.y || rot_z != rotationAngles.z) {
+            rotationAngles = glm::vec3(rot_x, rot_y, rot_z);
+            glm::quat rotation = glm::angleAxis(glm::radians(rot_x), glm::vec3(1.f, 0.0f, 0.0f))
+                * glm::angleAxis(glm::radians(rot_y), glm::vec3(0.f, 1.f, 0.0f))
+                * glm::angleAxis(glm::radians(rot_z), glm::vec3(0.f, 0.0f, 1.f));
+            rotationMatrix = glm::mat4_cast(rotation);
+        }
+        model = glm::translate(model, glm::vec3(rp_x, rp_y, rp_z));
+        model = model * rotationMatrix;
+        model = glm::translate(model, glm::vec3(-rp_x, -rp_y, -rp_z));
+
+        // spinning cubes: blended between the last two steps, then the batch kernel rebuilds their rotation matrices
+        if (SPIN_CUBES) {
+            QuatBatch::Interpolate(previousSpins.data(), spins.data(), simulation.Alpha, drawnSpins.data(), instanceCount);
+            QuatBatch::ToMatrices(drawnSpins.data(), rotations.data(), instanceCount);
+            glState.BindBuffer(GL_ARRAY_BUFFER, rotationVBO);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, instanceCount * sizeof(InstanceRotation), rotations.data());
+        }
+        
+        
+        //SCALE
+        if (SCALE_ENABLE && SCALE_X >= 0 && SCALE_Y >= 0 && SCALE_Z >= 0 && Sk >= 0) {
+            model = glm::scale(model, glm::vec3(SCALE_X, SCALE_Y, SCALE_Z));
+
+            sca_x = SCALE_X;
+            sca_y = SCALE_Y;
+            sca_z = SCALE_Z;
+
+            if (ASPECT_RATIO) {
+                model = glm::scale(model, glm::vec3(Sk*1.f, Sk*1.f, Sk*1.f));
+                sca_x = Sk;
+                sca_y = Sk;
+                sca_z = Sk;
+            }
+
+            if (!PERSPECTIVE_ENABLE) {
+                sca_x = sca_x * 500.f;
+                sca_y = sca_y * 500.f;
+                sca_z = sca_z * 500.f;
+            }
+            
+            SCALE_ENABLE = false;
+        }
+
+        else
+        {
+            model = glm::scale(model, glm::vec3(sca_x, sca_y, sca_z));
+        }
+
+        if (SHEAR_ENABLE) {
+
+            if (SaX_ENABLE) {
+                model = ShearTransform(model, 1.f, 0.f, 0.f);
+                past_sax = 1.f;
+                past_say = 0.f;
+                past_saz = 0.f;
+                SaY_ENABLE = false;
+                SaZ_ENABLE = false;
+            }
+            else if (SaY_ENABLE) {
+                model = ShearTransform(model, 0.f, 1.f, 0.f);
+                past_sax = 0.f;
+                past_say = 1.f;
+                past_saz = 0.f;
+                SaX_ENABLE = false;
+                SaZ_ENABLE = false;
+            }
+            else if (SaZ_ENABLE) {
+                model = ShearTransform(model, 0.f, 0.f, 1.f);
+                past_sax = 0.f;
+                past_say = 0.f;
+                past_saz = 1.f;
+                SaX_ENABLE = false;
+                SaY_ENABLE = false;
+            }
+            else {
+                past_sax = 0.f;
+                past_say = 0.f;
+                past_saz = 0.f;
+            }
+            
+
+            SHEAR_ENABLE = false;
+        }
+
+        else {
+            model = ShearTransform(model, past_sax, past_say, past_saz);
+        }
+
+        if (MIRROR_ENABLE) {
+            if (mXY_ENABLE) {
+                past_mxy = 1.f;
+                past_mxz = 0.f;
+                past_myz = 0.f;
+                model = Mirror(model, past_mxy, 0.f, 0.f);
+
+                mYZ_ENABLE = false;
+                mXZ_ENABLE = false;
+            }
+            else if (mXZ_ENABLE) {
+                past_mxz = 1.f;
+                past_mxy = 0.f;
+                past_myz = 0.f;
+                model = Mirror(model, 0.f, past_mxz, 0.f);
+
+                mXY_ENABLE = false;
+                mYZ_ENABLE = false;
+            }
+            else if (mYZ_ENABLE) {
+                past_myz = 1.f;
+                past_mxy = 0.f;
+                past_mxz = 0.f;
+                model = Mirror(model, 0.f, 0.f, past_myz);
+
+                mXY_ENABLE = false;
+                mXZ_ENABLE = false;
+            }
+            else {
+                past_mxy = 0.f;
+                past_mxz = 0.f;
+                past_myz = 0.f;
+            }
+
+            MIRROR_ENABLE = false;
+        }
+
+        else {
+            model = Mirror(model, past_mxy, past_mxz, past_myz);
+            
+        }
+
+      
+
+        // CHANGE Projection Mode Perspective/Ortho
+        if (PERSPECTIVE_ENABLE) {
+            projection = glm::perspective(glm::radians(45.0f), (float)framebufferWidth / (float)framebufferHeight, .001f, 100.0f);
+        }
+        else
+        {
+            projection = glm::ortho(
+                -static_cast<float>(framebufferWidth / 2.f),
+                static_cast<float>(framebufferWidth / 2.f),
+                -static_cast<float>(framebufferHeight /2.f),
+                static_cast<float>(framebufferHeight / 2.f),
+                0.1f,
+                10000.0f
+            );
+            
+        }
+        
+        glm::vec3 lightPos = glm::vec3(Lx, Ly, Lz);
+        PROFILE_STAGE(PROFILE_UNIFORMS);
+        // retrieve the matrix uniform locations
+        GLint modelLoc = ourShader.Location("model");
+        // pass them to the shaders (3 different ways)
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+        PROFILE_COUNT(PROFILE_UNIFORM_UPLOADS, 1);
+        ourShader.setMat4("view", view);
+        // note: currently we set the projection matrix each frame, but since the projection matrix rarely changes it's often best practice to set it outside the main loop only once.
+        ourShader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
+        ourShader.setVec3("lightPos", lightPos);
+        ourShader.setVec3("viewPos", camera.Position);
+        ourShader.setMat4("projection", projection);
+        
+        ourShader.setBool("TEX_ENABLE", TEX_ENABLE);
+
+        // render boxes
+        PROFILE_STAGE(PROFILE_SCENE_DRAW);
+        GPU_PROFILE_BEGIN(GPU_PASS_SCENE);
+        glState.BindVertexArray(VAO);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 36, instanceCount);
+        GPU_PROFILE_END(GPU_PASS_SCENE);
+        PROFILE_COUNT(PROFILE_DRAW_CALLS, 1);
+        PROFILE_COUNT(PROFILE_TRIANGLES, 12 * instanceCount);
+
+        // also draw the lamp object
+        lightCubeShader.use();
+        PROFILE_STAGE(PROFILE_UNIFORMS);
+        lightCubeShader.setMat4("projection", projection);
+        lightCubeShader.setMat4("view", view);
+        model = glm::mat4(1.0f);
+        model = glm::translate(model, lightPos);
+        if (!PERSPECTIVE_ENABLE) {
+            model = glm::scale(model, glm::vec3(0.1f * 500.f)); // a smaller cube
+        }
+        else {
+            model = glm::scale(model, glm::vec3(0.1f)); // a smaller cube
+        }
+        lightCubeShader.setMat4("model", model);
+
+        PROFILE_STAGE(PROFILE_SCENE_DRAW);
+        GPU_PROFILE_BEGIN(GPU_PASS_LIGHT);
+        glState.BindVertexArray(lightCubeVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+        GPU_PROFILE_END(GPU_PASS_LIGHT);
+        PROFILE_COUNT(PROFILE_DRAW_CALLS, 1);
+        PROFILE_COUNT(PROFILE_TRIANGLES, 12);
+
+        frameGraph.EndPass(scenePass);
+
+        // scene up to the window size, the UI goes on top at native resolution
+        if (upscalePass >= 0 && frameGraph.BeginPass(upscalePass)) {
+            GPU_PROFILE_BEGIN(GPU_PASS_UPSCALE);
+            if (dynamicResolution.Enabled) {
+                int sceneTextureWidth, sceneTextureHeight;
+                frameGraph.TargetSize(sceneColor, sceneTextureWidth, sceneTextureHeight);
+                dynamicResolution.Upscale(frameGraph.Texture(sceneColor), sceneTextureWidth, sceneTextureHeight);
+            }
+            GPU_PROFILE_END(GPU_PASS_UPSCALE);
+            frameGraph.EndPass(upscalePass);
+        }
+
+        PROFILE_STAGE(PROFILE_UI_RENDER);
+        ImGui::Render();
+        frameGraph.BeginPass(uiPass);
+        GPU_PROFILE_BEGIN(GPU_PASS_UI);
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        GPU_PROFILE_END(GPU_PASS_UI);
+        frameGraph.EndPass(uiPass);
+        int uiDrawCalls, uiTriangles;
+        ImGui_ImplOpenGL3_GetRenderStats(&uiDrawCalls, &uiTriangles);
+        PROFILE_COUNT(PROFILE_DRAW_CALLS, uiDrawCalls);
+        PROFILE_COUNT(PROFILE_TRIANGLES, uiTriangles);
+
+        // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
+        // -------------------------------------------------------------------------------
+        PROFILE_STAGE(PROFILE_SWAP);
+        dynamicResolution.EndFrame();
+        latency.Submit();
+        glfwSwapBuffers(window);
+        latency.Present();
+        pacer.EndFrame();
+
+        // render on demand: once nothing changes on screen anymore, sleep until input or a hot reload arrives.
+        // Animations and active widgets (a held slider, a blinking text cursor) keep the loop running
+        bool animating = (TEX_SOURCE == 1 && PROC_ANIMATE) || SPIN_CUBES;
+        if (!RENDER_ON_DEMAND || animating || ImGui::IsAnyItemActive() || inputLog.Replaying() || CAMERA_PATH)
+            redrawFrames = REDRAW_FRAMES;
+        else if (redrawFrames > 0)
+            redrawFrames--;
+        inputLog.EndFrame();
+        if (inputLog.Replaying() && inputLog.Finished)
+            glfwSetWindowShouldClose(window, true);
+        PROFILE_END_FRAME(); // the idle wait below is not part of the frame
+        TRACE_FLUSH();
+        ALLOC_END_FRAME();
+        uiPool.EndFrame();
+        while (redrawFrames == 0 && !glfwWindowShouldClose(window))
+        {
+            glfwWaitEventsTimeout(IDLE_WAIT_SECONDS);
+            if (hotReloader.Update())
+                RequestRedraw();
+            // nothing moved while asleep, the next frame must not simulate this time
+            lastFrame = (float)glfwGetTime();
+        }
+    }
+
+    // optional: de-allocate all resources once they've outlived their purpose:
+    // ------------------------------------------------------------------------
+    resources.Destroy(cubeVertexArray);
+    resources.Destroy(cubeVertexBuffer);
+    resources.Destroy(instanceBuffer);
+    resources.Destroy(rotationBuffer);
+    resources.Destroy(lightCubeVertexArray);
+    inputLog.Close();
+    if (flythrough)
+        printf("BENCHMARK::FLYTHROUGH %s %.1f s at %.4f s per frame\n", cameraPath.File.c_str(), cameraPath.Duration(), simulation.Step);
+    PrintBenchmarkSummary(pacer, simulation, dynamicResolution, frameGraph);
+    // the owners of GL objects are locals of main, their destructors would only run after glfwTerminate()
+    ourShader.Destroy();
+    lightCubeShader.Destroy();
+    procedural.Destroy();
+    atlas.Destroy();
+    textureManager.Destroy();
+    dynamicResolution.Destroy();
+    renderTargets.Clear();
+    GPU_PROFILE_SHUTDOWN();
+    pacer.Shutdown();
+    latency.Shutdown();
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+    // whatever is still alive now was never deleted, the context is current for one last check
+    resources.ReportLeaks();
+    // glfw: terminate, clearing all previously allocated GLFW resources.
+    // ------------------------------------------------------------------
+    glfwTerminate();
+    Tracer::Instance().Stop();
+    if (checkAllocations && AllocTracker::Instance().AllocatingFrames > 0)
+        return 1;
+    if (latencySlo > 0.0 && latency.Samples > 0 && latency.Percentile(99.0) > latencySlo)
+    {
+        std::cout << "ERROR::LATENCY::SLO_MISSED p99 " << latency.Percentile(99.0) << " ms > " << latencySlo << " ms" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
+// ---------------------------------------------------------------------------------------------------------
+void processInput(GLFWwindow* window)
+{
+    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+// glfw: whenever the window size changed (by OS or user resize) this callback function executes
+// ---------------------------------------------------------------------------------------------
+void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+    // the render loop reads the framebuffer size every frame and sets the viewports from it; note that width and
+    // height will be significantly larger than specified on retina displays.
+    RequestRedraw();
+}
+
+// input callbacks: only used to wake up the render loop, stamp the input for the latency tracker and record it,
+// ImGui's backend handles the events themselves
+// ----------------------------------------------------------------------------------------------------
+void cursor_position_callback(GLFWwindow* window, double xpos, double ypos)
+{
+    inputLog.Cursor(xpos, ypos);
+    LatencyTracker::Instance().Input();
+    RequestRedraw();
+}
+
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+{
+    inputLog.Button(button, action, mods);
+    LatencyTracker::Instance().Input();
+    RequestRedraw();
+}
+
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+    inputLog.Scroll(xoffset, yoffset);
+    LatencyTracker::Instance().Input();
+    RequestRedraw();
+}
+
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    inputLog.Key(key, action, mods);
+    LatencyTracker::Instance().Input();
+    RequestRedraw();
+}
+
+void char_callback(GLFWwindow* window, unsigned int c)
+{
+    inputLog.Char(c);
+    LatencyTracker::Instance().Input();
+    RequestRedraw();
+}
+
+void window_refresh_callback(GLFWwindow* window)
+{
+    RequestRedraw();
+}
+
+void RequestRedraw()
+{
+    redrawFrames = REDRAW_FRAMES;
+}
+
+// performance overlay: rolling frame times, the stage breakdown and the counters of the last frame
+void DrawPerformanceOverlay(FrameArena& arena, const PoolAllocator& uiPool, const FramePacer& pacer, const FixedTimestep& simulation, const DynamicResolution& resolution,
+    const FrameGraph& graph)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - 10.f, 10.f), ImGuiCond_Always, ImVec2(1.f, 0.f));
+    ImGui::SetNextWindowBgAlpha(0.6f);
+    ImGui::Begin("Performance", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+    ImGui::Text("%.1f FPS", io.Framerate);
+    ImGui::Text("%s, %d frames in flight, cap %s", FramePacer::SwapModeName(pacer.SwapMode), pacer.FramesInFlight, pacer.TargetFps > 0.0 ? arena.Format("%.0f", pacer.TargetFps) : "off");
+    ImGui::Text("Fence wait %.3f ms, cap wait %.3f ms, %lld stalls", pacer.FenceWait * 1000.0, pacer.CapWait * 1000.0, pacer.FenceStalls);
+    ImGui::Text("Simulation %.0f Hz, %d steps, alpha %.2f, %.2f s dropped", simulation.Hz, simulation.Steps, simulation.Alpha, simulation.DroppedTime);
+    if (resolution.Enabled)
+        ImGui::Text("Render scale %.0f%% %dx%d, GPU %.2f / %.1f ms, %lld changes", resolution.Scale * 100.f, resolution.Width, resolution.Height, resolution.GpuTime,
+            resolution.BudgetMs, resolution.Changes);
+    const RenderTargetPool& targets = graph.Pool();
+    ImGui::Text("Render targets %.1f MB in %d, %d of %d passes culled", targets.Bytes / (1024.f * 1024.f), targets.Targets, graph.CulledPasses, graph.Passes);
+    // GL memory by category, red above the --gpu-memory budget
+    const GLResourceRegistry& resources = GLResourceRegistry::Instance();
+    if (resources.OverBudget())
+        ImGui::TextColored(ImVec4(1.f, 0.3f, 0.3f, 1.f), "GPU memory %.1f / %.1f MB, peak %.1f MB", resources.TotalBytes / (1024.f * 1024.f),
+            resources.BudgetBytes / (1024.f * 1024.f), resources.PeakBytes / (1024.f * 1024.f));
+    else
+        ImGui::Text("GPU memory %.1f MB, peak %.1f MB", resources.TotalBytes / (1024.f * 1024.f), resources.PeakBytes / (1024.f * 1024.f));
+    for (int i = 0; i < RESOURCE_KIND_COUNT; i++)
+    {
+        if (resources.Counts[i] > 0)
+            ImGui::TextDisabled("%-14s %4d %9.2f MB", GLResourceRegistry::KindName(i), resources.Counts[i], resources.Bytes[i] / (1024.f * 1024.f));
+    }
+    if (resources.StaleUses > 0)
+        ImGui::Text("%lld stale handle uses", resources.StaleUses);
+    // input-to-present of the last frames that consumed input
+    const LatencyTracker& latency = LatencyTracker::Instance();
+    if (latency.Samples > 0)
+    {
+        ImGui::Text("Latency p50 %.1f p90 %.1f p99 %.1f ms", latency.RecentPercentile(50.0), latency.RecentPercentile(90.0), latency.RecentPercentile(99.0));
+        ImGui::TextDisabled("queue %.1f + cpu %.1f + gpu/present %.1f ms", latency.QueueTime, latency.CpuTime, latency.GpuTime);
+    }
+    else
+        ImGui::Text("Latency: no input yet");
+    // the pool counts its own traffic in every build
+    ImGui::Text("UI pool %.1f KB live, %.1f KB peak, %.1f / %.1f MB carved", uiPool.LiveBytes / 1024.f, uiPool.PeakBytes / 1024.f,
+        uiPool.CarvedBytes / (1024.f * 1024.f), uiPool.ReservedBytes / (1024.f * 1024.f));
+    ImGui::Text("UI pool %lld allocs %lld frees %lld bytes, %lld fallbacks", uiPool.FrameAllocations, uiPool.FrameFrees, uiPool.FrameBytes, uiPool.Fallbacks);
+#ifdef PROFILER_ENABLED
+    const Profiler& profiler = Profiler::Instance();
+    float maxTime = 1.f;
+    for (int i = 0; i < PROFILER_HISTORY; i++)
+        maxTime = std::max(maxTime, profiler.FrameHistory[i]);
+    char label[32];
+    snprintf(label, sizeof(label), "CPU %.2f ms", profiler.FrameTime * 1000.0);
+    ImGui::PlotLines("##FrameTimes", profiler.FrameHistory, PROFILER_HISTORY, profiler.FrameOffset, label, 0.f, maxTime * 1.2f, ImVec2(300.f, 60.f));
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++)
+        ImGui::Text("%-12s %7.3f ms", Profiler::StageName(i), profiler.StageTimes[i] * 1000.0);
+    ImGui::Separator();
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+        ImGui::Text("%-16s %lld", Profiler::CounterName(i), profiler.Counters[i]);
+
+    // GPU results lag a few frames behind, they are read without waiting
+    const GpuProfiler& gpu = GpuProfiler::Instance();
+    ImGui::Separator();
+    if (gpu.TimerSupported)
+        ImGui::Text("GPU %.3f ms (%d frames behind)", gpu.FrameTime * 1000.0, gpu.Latency);
+    else
+        ImGui::Text("GPU timer queries not supported");
+    for (int i = 0; i < GPU_PASS_COUNT; i++)
+    {
+        ImGui::Text("%-12s %7.3f ms", GpuProfiler::PassName(i), gpu.PassTimes[i] * 1000.0);
+        if (gpu.PrimitivesSupported || gpu.SamplesSupported)
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("%lld prims %lld samples", gpu.Primitives[i], gpu.Samples[i]);
+        }
+    }
+
+    // heap traffic of the render thread, a steady state frame should show none
+    const AllocTracker& allocs = AllocTracker::Instance();
+    ImGui::Separator();
+    ImGui::Text("Heap %lld allocs %lld bytes", allocs.FrameAllocations, allocs.FrameBytes);
+    ImGui::Text("Allocating frames %lld (after %d warm-up)", allocs.AllocatingFrames, ALLOC_WARMUP_FRAMES);
+    for (int i = 0; i < allocs.CallsiteCount && i < 4; i++)
+    {
+        const AllocCallsite& callsite = allocs.Callsites[i];
+        if (callsite.Depth == 0)
+            continue;
+        void* caller = callsite.Frames[AllocTracker::Caller(callsite)];
+        const char* symbol = AllocTracker::Symbol(caller);
+        ImGui::TextDisabled("%s", arena.Format("%lldx %p %.40s", callsite.Allocations, caller, symbol ? symbol : ""));
+    }
+    ImGui::Text("Frame arena %.1f / %.1f KB", arena.Used / 1024.f, arena.Capacity / 1024.f);
+#else
+    ImGui::Text("Instrumentation compiled out, build with PROFILER_INSTRUMENTATION");
+#endif
+    ImGui::End();
+}
+
+// benchmark summary: averages over the whole run, printed at exit
+void PrintBenchmarkSummary(const FramePacer& pacer, const FixedTimestep& simulation, const DynamicResolution& resolution,
+    const FrameGraph& graph)
+{
+    if (pacer.Frames == 0)
+        return;
+    printf("BENCHMARK::FRAMES %lld\n", pacer.Frames);
+    // stage timings and allocation counts only exist in instrumented builds, the rest is measured in every build
+#ifdef PROFILER_ENABLED
+    const Profiler& profiler = Profiler::Instance();
+    const GpuProfiler& gpu = GpuProfiler::Instance();
+    if (profiler.Frames > 0)
+    {
+        printf("BENCHMARK::CPU_FRAME %.3f ms\n", profiler.TotalFrameTime * 1000.0 / profiler.Frames);
+        for (int i = 0; i < PROFILE_STAGE_COUNT; i++)
+            printf("BENCHMARK::CPU %-12s %.3f ms\n", Profiler::StageName(i), profiler.TotalStageTimes[i] * 1000.0 / profiler.Frames);
+    }
+    if (gpu.TimerSupported && gpu.Frames > 0)
+    {
+        printf("BENCHMARK::GPU_FRAME %.3f ms (%lld frames, %lld dropped)\n", gpu.TotalFrameTime * 1000.0 / gpu.Frames, gpu.Frames, gpu.Dropped);
+        for (int i = 0; i < GPU_PASS_COUNT; i++)
+            printf("BENCHMARK::GPU %-12s %.3f ms\n", GpuProfiler::PassName(i), gpu.TotalPassTimes[i] * 1000.0 / gpu.Frames);
+    }
+#endif
+    printf("BENCHMARK::PACING %s, %d frames in flight, cap %.0f fps\n", FramePacer::SwapModeName(pacer.SwapMode), pacer.FramesInFlight, pacer.TargetFps);
+    printf("BENCHMARK::FENCE_WAIT %.3f ms (%lld stalls)\n", pacer.TotalFenceWait * 1000.0 / pacer.Frames, pacer.FenceStalls);
+    printf("BENCHMARK::CAP_WAIT %.3f ms\n", pacer.TotalCapWait * 1000.0 / pacer.Frames);
+    printf("BENCHMARK::SIMULATION %.0f Hz, %lld steps, %.3f s dropped\n", simulation.Hz, simulation.TotalSteps, simulation.DroppedTime);
+    if (resolution.Frames > 0)
+        printf("BENCHMARK::RESOLUTION average scale %.2f (%.2f to %.2f), %lld changes, budget %.1f ms\n", resolution.TotalScale / resolution.Frames,
+            resolution.MinScale, resolution.MaxScale, resolution.Changes, resolution.BudgetMs);
+    printf("BENCHMARK::RENDER_TARGETS %.1f MB in %d targets, %lld allocations\n", graph.Pool().Bytes / (1024.0 * 1024.0), graph.Pool().Targets,
+        graph.Pool().Allocations);
+    const GLResourceRegistry& resources = GLResourceRegistry::Instance();
+    printf("BENCHMARK::GPU_MEMORY peak %.1f MB, %lld objects created, %lld destroyed, %lld stale handle uses\n", resources.PeakBytes / (1024.0 * 1024.0),
+        resources.Created, resources.Destroyed, resources.StaleUses);
+    const LatencyTracker& latency = LatencyTracker::Instance();
+    if (latency.Samples > 0)
+    {
+        printf("BENCHMARK::LATENCY p50 %.2f p90 %.2f p99 %.2f max %.2f ms (%lld samples, %lld dropped)\n", latency.Percentile(50.0), latency.Percentile(90.0),
+            latency.Percentile(99.0), latency.Max(), latency.Samples, latency.Dropped);
+        printf("BENCHMARK::LATENCY_SPLIT queue %.3f cpu %.3f gpu/present %.3f ms\n", latency.TotalQueueTime / latency.Samples,
+            latency.TotalCpuTime / latency.Samples, latency.TotalGpuTime / latency.Samples);
+    }
+#ifdef PROFILER_ENABLED
+    printf("BENCHMARK::ALLOCATING_FRAMES %lld\n", AllocTracker::Instance().AllocatingFrames);
+#endif
+}
+
+// hands the ImGui backend the state it would otherwise read back with glGet, as long as the cache knows all of it
+// ----------------------------------------------------------------------------------------------------------------
+bool QueryImGuiGLState(ImGui_ImplOpenGL3_State* state, void* userData)
+{
+    const GLStateCache& cache = *(const GLStateCache*)userData;
+    if (!cache.Complete())
+        return false;
+    state->ActiveTexture = cache.ActiveTextureUnit();
+    state->Program = cache.Program();
+    state->Texture = cache.Texture(0, GL_TEXTURE_2D);
+    state->Sampler = cache.Sampler();
+    state->ArrayBuffer = cache.ArrayBuffer();
+    state->VertexArray = cache.VertexArray();
+    state->PolygonMode[0] = state->PolygonMode[1] = (int)cache.PolygonModeValue();
+    for (int i = 0; i < 4; i++)
+    {
+        state->Viewport[i] = cache.ViewportRect()[i];
+        state->ScissorBox[i] = cache.ScissorRect()[i];
+    }
+    state->BlendSrcRgb = cache.BlendFunc()[0];
+    state->BlendDstRgb = cache.BlendFunc()[1];
+    state->BlendSrcAlpha = cache.BlendFunc()[2];
+    state->BlendDstAlpha = cache.BlendFunc()[3];
+    state->BlendEquationRgb = cache.BlendEquation()[0];
+    state->BlendEquationAlpha = cache.BlendEquation()[1];
+    state->EnableBlend = cache.IsEnabled(GL_BLEND);
+    state->EnableCullFace = cache.IsEnabled(GL_CULL_FACE);
+    state->EnableDepthTest = cache.IsEnabled(GL_DEPTH_TEST);
+    state->EnableStencilTest = cache.IsEnabled(GL_STENCIL_TEST);
+    state->EnableScissorTest = cache.IsEnabled(GL_SCISSOR_TEST);
+    state->EnablePrimitiveRestart = cache.IsEnabled(GL_PRIMITIVE_RESTART);
+    return true;
+}
+
+// lays the instances out in a cube shaped grid around the origin and cycles them through the texture regions
+void FillInstances(InstanceData* instances, int count, const std::vector<AtlasRegion>& regions)
+{
+    int side = 1;
+    while (side * side * side < count)
+        side++;
+    float half = (side - 1) * 0.5f;
+    for (int i = 0; i < count; i++)
+    {
+        float x = (float)(i % side) - half;
+        float y = (float)((i / side) % side) - half;
+        float z = (float)(i / (side * side)) - half;
+        AtlasRegion region = { 0.f, glm::vec4(0.f, 0.f, 1.f, 1.f) };
+        if (!regions.empty())
+            region = regions[i % regions.size()];
+        instances[i].OffsetLayer = glm::vec4(x * 1.5f, y * 1.5f, -z * 1.5f, region.Layer);
+        instances[i].UVRect = region.UVRect;
+    }
+}
+
+// gives every cube its own spin axis and speed, the step quaternions are built here once instead of every frame
+void FillSpinSteps(glm::quat* steps, int count, float stepSeconds)
+{
+    for (int i = 0; i < count; i++)
+    {
+        // a fixed scatter of directions, the golden angle keeps neighbouring cubes from spinning alike
+        float azimuth = i * 2.39996f;
+        float height = 1.f - 2.f * ((i * 0.618034f) - (int)(i * 0.618034f));
+        float radius = sqrt(1.f - height * height);
+        glm::vec3 axis(radius * cos(azimuth), height, radius * sin(azimuth));
+        float degreesPerSecond = 30.f + (i % 7) * 10.f;
+        steps[i] = glm::angleAxis(glm::radians(degreesPerSecond * stepSeconds), axis);
+    }
+}
+
+glm::mat4 ShearTransform(glm::mat4 model, float SaX, float SaY, float SaZ) {
+    glm::mat4 shear = glm::mat4x4(
+        1.f, 0.f, 0.f, 0.f,
+        0.f, 1.f, 0.f, 0.f,
+        0.f, 0.f, 1.f, 0.f,
+        0.f, 0.f, 0.f, 1.f);
+
+    model = glm::translate(model, glm::vec3(0.f, 0.f, 0.f));
+    // X Shear
+    if (SaX) {
+        shear[0][1] = 1.f;
+        shear[0][2] = 1.f;
+
+    }
+    //Y Shear
+    else if (SaY) {
+        shear[1][0] = 1.f;
+        shear[1][2] = 1.f;
+    }
+    //Z Shear
+    else if (SaZ) {
+        shear[2][0] = 1.f;
+        shear[2][1] = 1.f;
+    }
+    model = shear * model;
+
+    return model;
+}
+
+glm::mat4 Mirror(glm::mat4 model, float aXY, float aXZ, float aYZ) {
+    glm::mat4 reflect = glm::mat4x4(
+        1.f, 0.f, 0.f, 0.f,
+        0.f, 1.f, 0.f, 0.f,
+        0.f, 0.f, 1.f, 0.f,
+        0.f, 0.f, 0.f, 1.f);
+
+    if (aXY) {
+        reflect[2][2] = -1.f;
+    }
+    else if (aXZ) {
+        reflect[1][1] = -1.f;
+    }
+    else if (aYZ) {
+        reflect[0][0] = -1.f;
+    }
+
+    model = reflect * model;
+
+    return model;
 }
\ No newline at end of file